@@ -0,0 +1,580 @@
+#pragma once
+
+/*
+ *	flat map data container, keys and mapped values are stored in two separate sorted vectors (columns)
+ *
+ *	lookups only touch the key column, a range insertion sorts the new elements and merges them once
+ */
+
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include "flat_set.h"
+
+namespace cust					//customized / non-standard
+{
+	//pair of references returned by operator * of flat_map_iterator, a distinct type for its common reference with the value type
+	template<class Key, class T>
+	struct flat_map_reference : public std::pair<const Key&, T&>
+	{
+		using std::pair<const Key&, T&>::pair;
+	};
+}
+
+/*
+ *	the common reference of the proxy and the value type is the value type (a copy),
+ *	so flat_map_iterator and its const version model std::random_access_iterator
+ */
+template<class Key, class T, class U1, class U2, template<class> class TQual, template<class> class UQual>
+struct std::basic_common_reference<cust::flat_map_reference<Key, T>, std::pair<U1, U2>, TQual, UQual>
+{
+	using type = std::pair<std::remove_const_t<Key>, std::remove_const_t<T>>;
+};
+
+template<class U1, class U2, class Key, class T, template<class> class TQual, template<class> class UQual>
+struct std::basic_common_reference<std::pair<U1, U2>, cust::flat_map_reference<Key, T>, TQual, UQual>
+{
+	using type = std::pair<std::remove_const_t<Key>, std::remove_const_t<T>>;
+};
+
+namespace cust
+{
+	/*
+	 *	flat map iterator, a random access iterator over the key column and the mapped value column
+	 *
+	 *	operator * returns a pair of references (a proxy), use "auto" or "const auto&" in range-based for loops
+	 */
+	template<class Key, class T>
+	class flat_map_iterator
+	{
+		//friend class forward declaration
+		template<class, class>
+		friend class flat_map_iterator;
+
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type        = std::pair<std::remove_const_t<Key>, std::remove_const_t<T>>;
+			using difference_type   = std::ptrdiff_t;
+			using reference         = flat_map_reference<Key, T>;
+
+			//pointer-like proxy for operator ->
+			struct pointer
+			{
+				reference ref;
+
+				reference* operator -> () noexcept
+				{
+					return std::addressof(ref);
+				}
+			};
+
+			flat_map_iterator() noexcept = default;
+
+			flat_map_iterator(const Key* k, T* v) noexcept : key { k }, val { v }
+			{
+			}
+
+			//type conversion from iterator to const_iterator
+			template<class U, class = std::enable_if_t<std::is_same_v<const U, T>>>
+			flat_map_iterator(const flat_map_iterator<Key, U>& other) noexcept : key { other.key }, val { other.val }
+			{
+			}
+
+			reference operator * () const noexcept
+			{
+				return { *key, *val };
+			}
+
+			pointer operator -> () const noexcept
+			{
+				return pointer { **this };
+			}
+
+			reference operator [] (difference_type n) const noexcept
+			{
+				return { key[n], val[n] };
+			}
+
+			auto& operator ++ () noexcept
+			{
+				++key;
+				++val;
+
+				return *this;
+			}
+
+			auto operator ++ (int) noexcept
+			{
+				auto tmp { *this };
+
+				operator++();
+
+				return tmp;
+			}
+
+			auto& operator -- () noexcept
+			{
+				--key;
+				--val;
+
+				return *this;
+			}
+
+			auto operator -- (int) noexcept
+			{
+				auto tmp { *this };
+
+				operator--();
+
+				return tmp;
+			}
+
+			auto& operator += (difference_type n) noexcept
+			{
+				key += n;
+				val += n;
+
+				return *this;
+			}
+
+			auto& operator -= (difference_type n) noexcept
+			{
+				return operator+=(-n);
+			}
+
+			flat_map_iterator operator + (difference_type n) const noexcept
+			{
+				return flat_map_iterator(key + n, val + n);
+			}
+
+			friend flat_map_iterator operator + (difference_type n, const flat_map_iterator& iter) noexcept
+			{
+				return iter + n;
+			}
+
+			flat_map_iterator operator - (difference_type n) const noexcept
+			{
+				return flat_map_iterator(key - n, val - n);
+			}
+
+			difference_type operator - (const flat_map_iterator& other) const noexcept
+			{
+				return key - other.key;
+			}
+
+			bool operator == (const flat_map_iterator& other) const noexcept { return key == other.key; }
+			bool operator != (const flat_map_iterator& other) const noexcept { return key != other.key; }
+			bool operator <  (const flat_map_iterator& other) const noexcept { return key <  other.key; }
+			bool operator <= (const flat_map_iterator& other) const noexcept { return key <= other.key; }
+			bool operator >  (const flat_map_iterator& other) const noexcept { return key >  other.key; }
+			bool operator >= (const flat_map_iterator& other) const noexcept { return key >= other.key; }
+
+			//gets the index of the element
+			difference_type index(const Key* first) const noexcept
+			{
+				return key - first;
+			}
+
+		private:
+			const Key* key { nullptr };			//pointer pointing to the key
+			T*         val { nullptr };			//pointer pointing to the mapped value
+	};
+
+	template<class Key, class T, class Compare = std::less<Key>, class KeyContainer = vector<Key>, class MappedContainer = vector<T>>
+	class flat_map
+	{
+		public:
+			using key_type               = Key;
+			using mapped_type            = T;
+			using value_type             = std::pair<Key, T>;
+			using size_type              = std::size_t;
+			using difference_type        = std::ptrdiff_t;
+			using key_compare            = Compare;
+			using key_container_type     = KeyContainer;
+			using mapped_container_type  = MappedContainer;
+			using iterator               = flat_map_iterator<key_type, mapped_type>;
+			using const_iterator         = flat_map_iterator<key_type, const mapped_type>;
+			using reverse_iterator       = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+			//Function object to compare objects of value_type by their keys
+			struct value_compare
+			{
+				bool operator () (const value_type& lhs, const value_type& rhs) const
+				{
+					return cmp(lhs.first, rhs.first);
+				}
+
+				key_compare cmp {};
+			};
+
+			//default constructor
+			flat_map() = default;
+
+			//range constructor
+			template<class InputIter>
+			flat_map(InputIter first, InputIter last)
+			{
+				insert(first, last);
+			}
+
+			//constructor with initializer list
+			flat_map(std::initializer_list<value_type> init)
+			{
+				insert(init);
+			}
+
+			//constructor with the columns of sorted and unique keys and their mapped values (no sorting)
+			flat_map(sorted_unique_t, key_container_type key_cont, mapped_container_type mapped_cont) : keys { std::move(key_cont) }, vals { std::move(mapped_cont) }
+			{
+				if (keys.size() != vals.size())
+					throw std::length_error("the sizes of the key container and the mapped container are different");
+			}
+
+			//assignment with initializer list
+			flat_map& operator = (std::initializer_list<value_type> init)
+			{
+				clear();
+
+				insert(init);
+
+				return *this;
+			}
+
+			//returns the function object that compares the keys
+			key_compare key_comp() const
+			{
+				return cmp;
+			}
+
+			//returns the function object that compares objects of value_type
+			value_compare value_comp() const
+			{
+				return value_compare { cmp };
+			}
+
+			//checks if the container is empty
+			bool empty() const noexcept
+			{
+				return keys.empty();
+			}
+
+			//gets the number of elements of the container
+			size_type size() const noexcept
+			{
+				return keys.size();
+			}
+
+			//clears all elements of the container
+			void clear() noexcept
+			{
+				keys.clear();
+				vals.clear();
+			}
+
+			//reserves (memory) capacity for the container
+			void reserve(size_type new_cap)
+			{
+				keys.reserve(new_cap);
+				vals.reserve(new_cap);
+			}
+
+			//access a specified element with bounds checking
+			mapped_type& at(const key_type& key)
+			{
+				auto iter { find(key) };
+
+				if (iter == end())
+					throw std::out_of_range("invalid element access: no such key");
+
+				return iter->second;
+			}
+
+			const mapped_type& at(const key_type& key) const
+			{
+				auto iter { find(key) };
+
+				if (iter == end())
+					throw std::out_of_range("invalid element access: no such key");
+
+				return iter->second;
+			}
+
+			//access or insert a specified element
+			mapped_type& operator [] (const key_type& key)
+			{
+				return try_emplace(key).first->second;
+			}
+
+			mapped_type& operator [] (key_type&& key)
+			{
+				return try_emplace(std::move(key)).first->second;
+			}
+
+			//inserts an element into the container (with copy semantics)
+			std::pair<iterator, bool> insert(const value_type& value)
+			{
+				return try_emplace(value.first, value.second);
+			}
+
+			//inserts an element into the container (with move semantics)
+			std::pair<iterator, bool> insert(value_type&& value)
+			{
+				return try_emplace(std::move(value.first), std::move(value.second));
+			}
+
+			/*
+			 *	inserts a range of elements [first, last) into the container
+			 *
+			 *	1. copies the new elements into a buffer and sorts it (stable, the first one of the duplicate keys wins)
+			 *	2. merges the buffer and the columns into new columns once (O(n + m log m))
+			 */
+			template<class InputIter>
+			void insert(InputIter first, InputIter last)
+			{
+				vector<value_type> buf {};
+
+				for ( ; first != last; ++first)
+					buf.push_back(value_type(*first));
+
+				std::stable_sort(buf.begin(), buf.end(), value_comp());
+
+				key_container_type    new_keys {};
+				mapped_container_type new_vals {};
+
+				new_keys.reserve(keys.size() + buf.size());
+				new_vals.reserve(keys.size() + buf.size());
+
+				size_type i { 0 };
+
+				for (auto j { buf.begin() }; i != keys.size() || j != buf.end(); )
+				{
+					if (j == buf.end() || (i != keys.size() && cmp(keys[i], j->first)))
+					{
+						new_keys.push_back(std::move(keys[i]));
+						new_vals.push_back(std::move(vals[i]));
+
+						++i;
+					}
+					else if (i == keys.size() || cmp(j->first, keys[i]))
+					{
+						new_keys.push_back(std::move(j->first));
+						new_vals.push_back(std::move(j->second));
+
+						//skips the duplicate new elements
+						for (++j; j != buf.end() && !cmp(new_keys.back(), j->first); ++j);
+					}
+					else
+						++j;
+				}
+
+				keys = std::move(new_keys);
+				vals = std::move(new_vals);
+			}
+
+			//inserts the elements of the initializer list into the container
+			void insert(std::initializer_list<value_type> init)
+			{
+				insert(init.begin(), init.end());
+			}
+
+			//inserts an element into the container with its value constructed in-place
+			template<class... Args>
+			std::pair<iterator, bool> emplace(Args&&... args)
+			{
+				value_type value(std::forward<Args>(args)...);
+
+				return try_emplace(std::move(value.first), std::move(value.second));
+			}
+
+			//inserts in-place if the key does not exist, does nothing if the key exists
+			template<class K, class... Args>
+			std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+			{
+				auto idx { static_cast<size_type>(lower_bound_ptr(key) - keys.data()) };
+
+				if (idx != keys.size() && !cmp(key, keys[idx]))
+					return { make_iterator(idx), false };
+
+				//the mapped value is constructed first and the key is taken back if inserting the mapped value throws,
+				//so the columns always have the same length (strong exception guarantee)
+				mapped_type val(std::forward<Args>(args)...);
+
+				keys.insert(keys.begin() + idx, key_type(std::forward<K>(key)));
+
+				try
+				{
+					vals.insert(vals.begin() + idx, std::move(val));
+				}
+				catch (...)
+				{
+					keys.erase(keys.begin() + idx);
+
+					throw;
+				}
+
+				return { make_iterator(idx), true };
+			}
+
+			//removes specified elements from the container
+			iterator erase(const_iterator pos)
+			{
+				auto idx { pos.index(keys.data()) };
+
+				keys.erase(keys.begin() + idx);
+				vals.erase(vals.begin() + idx);
+
+				return make_iterator(idx);
+			}
+
+			iterator erase(iterator pos)
+			{
+				return erase(const_iterator(pos));
+			}
+
+			size_type erase(const key_type& key)
+			{
+				auto pos { find(key) };
+
+				if (pos == end())
+					return 0;
+
+				erase(pos);
+
+				return 1;
+			}
+
+			//exchanges the contents of the container with those of other
+			void swap(flat_map& other) noexcept
+			{
+				std::swap(keys, other.keys);
+				std::swap(vals, other.vals);
+				std::swap(cmp,  other.cmp);
+			}
+
+			//returns the number of elements with the same key
+			size_type count(const key_type& key) const
+			{
+				return contains(key) ? 1 : 0;
+			}
+
+			//finds the element with the same key
+			iterator find(const key_type& key)
+			{
+				auto idx { find_index(key) };
+
+				return idx == keys.size() ? end() : make_iterator(idx);
+			}
+
+			const_iterator find(const key_type& key) const
+			{
+				auto idx { find_index(key) };
+
+				return idx == keys.size() ? end() : make_iterator(idx);
+			}
+
+			//checks if there is an element with the same key
+			bool contains(const key_type& key) const
+			{
+				return find_index(key) != keys.size();
+			}
+
+			//finds the first element with its key that is not less than the function argument
+			iterator lower_bound(const key_type& key)
+			{
+				return make_iterator(lower_bound_ptr(key) - keys.data());
+			}
+
+			const_iterator lower_bound(const key_type& key) const
+			{
+				return make_iterator(lower_bound_ptr(key) - keys.data());
+			}
+
+			//finds the first element with its key that is greater than the function argument
+			iterator upper_bound(const key_type& key)
+			{
+				return make_iterator(flat_upper_bound(keys.data(), keys.size(), key, cmp) - keys.data());
+			}
+
+			const_iterator upper_bound(const key_type& key) const
+			{
+				return make_iterator(flat_upper_bound(keys.data(), keys.size(), key, cmp) - keys.data());
+			}
+
+			//direct access to the key column and the mapped value column
+			const key_container_type& keys_container() const noexcept
+			{
+				return keys;
+			}
+
+			const mapped_container_type& values_container() const noexcept
+			{
+				return vals;
+			}
+
+			//returns an iterator to the beginning
+			iterator       begin()        noexcept { return make_iterator(0); }
+			const_iterator begin()  const noexcept { return make_iterator(0); }
+			const_iterator cbegin() const noexcept { return begin(); }
+
+			//returns an iterator to the end
+			iterator       end()        noexcept { return make_iterator(keys.size()); }
+			const_iterator end()  const noexcept { return make_iterator(keys.size()); }
+			const_iterator cend() const noexcept { return end(); }
+
+			//returns a reverse iterator to the beginning
+			reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+			const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+			const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+			//returns a reverse iterator to the end
+			reverse_iterator       rend()        noexcept { return reverse_iterator(begin()); }
+			const_reverse_iterator rend()  const noexcept { return const_reverse_iterator(begin()); }
+			const_reverse_iterator crend() const noexcept { return rend(); }
+
+		private:
+			//makes an iterator pointing to the idx-th element
+			iterator make_iterator(difference_type idx) noexcept
+			{
+				return iterator(keys.data() + idx, vals.data() + idx);
+			}
+
+			const_iterator make_iterator(difference_type idx) const noexcept
+			{
+				return const_iterator(keys.data() + idx, vals.data() + idx);
+			}
+
+			//finds the first key that is not less than the key (branchless binary search over the key column)
+			template<class K>
+			const key_type* lower_bound_ptr(const K& key) const
+			{
+				return flat_lower_bound(keys.data(), keys.size(), key, cmp);
+			}
+
+			//finds the index of the key, size() if the key does not exist
+			size_type find_index(const key_type& key) const
+			{
+				auto ptr { lower_bound_ptr(key) };
+				auto idx { static_cast<size_type>(ptr - keys.data()) };
+
+				return idx != keys.size() && !cmp(key, *ptr) ? idx : keys.size();
+			}
+
+			key_container_type    keys {};			//sorted and unique keys
+			mapped_container_type vals {};			//mapped values, vals[i] is the mapped value of keys[i]
+			key_compare           cmp  {};			//key comparison function
+	};
+
+	template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+	bool operator == (const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs, const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs)
+	{
+		return lhs.keys_container() == rhs.keys_container() && lhs.values_container() == rhs.values_container();
+	}
+
+	template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+	bool operator != (const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs, const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+}
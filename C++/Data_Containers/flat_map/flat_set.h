@@ -0,0 +1,326 @@
+#pragma once
+
+/*
+ *	flat set data container, elements are stored in a sorted vector
+ *
+ *	lookups are binary searches over contiguous memory, insert() and erase() move the elements after the position (O(n))
+ *	a range insertion sorts the new elements and merges them once
+ */
+
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include "vector.h"
+
+namespace cust					//customized / non-standard
+{
+	//tag to indicate that the elements of a range are sorted and unique
+	struct sorted_unique_t
+	{
+		explicit sorted_unique_t() = default;
+	};
+
+	inline constexpr sorted_unique_t sorted_unique {};
+
+	/*
+	 *	finds the first element in [first, first + n) that is not less than val
+	 *
+	 *	branchless binary search: the loop runs exactly log2(n) times, and the conditional move replaces the unpredictable branch
+	 */
+	template<class T, class Ty, class Compare>
+	const T* flat_lower_bound(const T* first, std::size_t n, const Ty& val, const Compare& cmp)
+	{
+		if (n == 0)
+			return first;
+
+		for ( ; 1 < n; )
+		{
+			auto half { n / 2 };
+
+			first = cmp(first[half], val) ? first + half : first;
+			n    -= half;
+		}
+
+		return first + cmp(*first, val);
+	}
+
+	//finds the first element in [first, first + n) that is greater than val (branchless binary search)
+	template<class T, class Ty, class Compare>
+	const T* flat_upper_bound(const T* first, std::size_t n, const Ty& val, const Compare& cmp)
+	{
+		if (n == 0)
+			return first;
+
+		for ( ; 1 < n; )
+		{
+			auto half { n / 2 };
+
+			first = cmp(val, first[half]) ? first : first + half;
+			n    -= half;
+		}
+
+		return first + !cmp(val, *first);
+	}
+
+	template<class Key, class Compare = std::less<Key>, class KeyContainer = vector<Key>>
+	class flat_set
+	{
+		public:
+			using key_type               = Key;
+			using value_type             = Key;
+			using size_type              = std::size_t;
+			using difference_type        = std::ptrdiff_t;
+			using key_compare            = Compare;
+			using value_compare          = Compare;
+			using container_type         = KeyContainer;
+			using reference              = value_type&;
+			using const_reference        = const value_type&;
+			using pointer                = value_type*;
+			using const_pointer          = const value_type*;
+			using iterator               = const value_type*;
+			using const_iterator         = const value_type*;
+			using reverse_iterator       = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+			//default constructor
+			flat_set() = default;
+
+			//range constructor
+			template<class InputIter>
+			flat_set(InputIter first, InputIter last)
+			{
+				insert(first, last);
+			}
+
+			//constructor with initializer list
+			flat_set(std::initializer_list<value_type> init)
+			{
+				insert(init);
+			}
+
+			//constructor with a container of sorted and unique elements (no sorting)
+			flat_set(sorted_unique_t, container_type cont) : keys { std::move(cont) }
+			{
+			}
+
+			//assignment with initializer list
+			flat_set& operator = (std::initializer_list<value_type> init)
+			{
+				clear();
+
+				insert(init);
+
+				return *this;
+			}
+
+			//returns the function object that compares the keys
+			key_compare key_comp() const
+			{
+				return cmp;
+			}
+
+			//returns the function object that compares objects of value_type
+			value_compare value_comp() const
+			{
+				return cmp;
+			}
+
+			//checks if the container is empty
+			bool empty() const noexcept
+			{
+				return keys.empty();
+			}
+
+			//gets the number of elements of the container
+			size_type size() const noexcept
+			{
+				return keys.size();
+			}
+
+			//clears all elements of the container
+			void clear() noexcept
+			{
+				keys.clear();
+			}
+
+			//reserves (memory) capacity for the container
+			void reserve(size_type new_cap)
+			{
+				keys.reserve(new_cap);
+			}
+
+			//inserts an element into the container (with copy semantics)
+			std::pair<iterator, bool> insert(const value_type& value)
+			{
+				return emplace(value);
+			}
+
+			//inserts an element into the container (with move semantics)
+			std::pair<iterator, bool> insert(value_type&& value)
+			{
+				return emplace(std::move(value));
+			}
+
+			//inserts a range of elements [first, last) into the container, sorts them and merges them once
+			template<class InputIter>
+			void insert(InputIter first, InputIter last)
+			{
+				container_type buf {};
+
+				for ( ; first != last; ++first)
+					buf.push_back(*first);
+
+				std::stable_sort(buf.begin(), buf.end(), cmp);
+
+				container_type merged {};
+
+				merged.reserve(keys.size() + buf.size());
+
+				for (auto i { keys.begin() }, j { buf.begin() }; i != keys.end() || j != buf.end(); )
+				{
+					if (j == buf.end() || (i != keys.end() && cmp(*i, *j)))
+						merged.push_back(std::move(*i++));
+					else if (i == keys.end() || cmp(*j, *i))
+					{
+						merged.push_back(std::move(*j++));
+
+						//skips the duplicate new elements
+						for ( ; j != buf.end() && !cmp(merged.back(), *j); ++j);
+					}
+					else
+						++j;
+				}
+
+				keys = std::move(merged);
+			}
+
+			//inserts the elements of the initializer list into the container
+			void insert(std::initializer_list<value_type> init)
+			{
+				insert(init.begin(), init.end());
+			}
+
+			//inserts an element into the container with its value constructed in-place
+			template<class... Args>
+			std::pair<iterator, bool> emplace(Args&&... args)
+			{
+				value_type value(std::forward<Args>(args)...);
+
+				auto pos { lower_bound(value) };
+
+				if (pos != end() && !cmp(value, *pos))
+					return { pos, false };
+
+				auto idx { pos - begin() };
+
+				keys.insert(keys.begin() + idx, std::move(value));
+
+				return { begin() + idx, true };
+			}
+
+			//removes specified elements from the container
+			iterator erase(const_iterator pos)
+			{
+				auto idx { pos - begin() };
+
+				keys.erase(keys.begin() + idx);
+
+				return begin() + idx;
+			}
+
+			size_type erase(const key_type& key)
+			{
+				auto pos { find(key) };
+
+				if (pos == end())
+					return 0;
+
+				erase(pos);
+
+				return 1;
+			}
+
+			//exchanges the contents of the container with those of other
+			void swap(flat_set& other) noexcept
+			{
+				std::swap(keys, other.keys);
+				std::swap(cmp,  other.cmp);
+			}
+
+			//returns the number of elements with the same key
+			size_type count(const key_type& key) const
+			{
+				return find(key) == end() ? 0 : 1;
+			}
+
+			//finds the element with the same key
+			const_iterator find(const key_type& key) const
+			{
+				auto pos { lower_bound(key) };
+
+				return pos != end() && !cmp(key, *pos) ? pos : end();
+			}
+
+			//checks if there is an element with the same key
+			bool contains(const key_type& key) const
+			{
+				return find(key) != end();
+			}
+
+			//finds the first element with its key that is not less than the function argument
+			const_iterator lower_bound(const key_type& key) const
+			{
+				return flat_lower_bound(keys.data(), keys.size(), key, cmp);
+			}
+
+			//finds the first element with its key that is greater than the function argument
+			const_iterator upper_bound(const key_type& key) const
+			{
+				return flat_upper_bound(keys.data(), keys.size(), key, cmp);
+			}
+
+			//direct access to the underlying sorted container
+			const container_type& keys_container() const noexcept
+			{
+				return keys;
+			}
+
+			//returns an iterator to the beginning
+			const_iterator begin()  const noexcept { return keys.data(); }
+			const_iterator cbegin() const noexcept { return begin(); }
+
+			//returns an iterator to the end
+			const_iterator end()  const noexcept { return keys.data() + keys.size(); }
+			const_iterator cend() const noexcept { return end(); }
+
+			//returns a reverse iterator to the beginning
+			const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+			const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+			//returns a reverse iterator to the end
+			const_reverse_iterator rend()  const noexcept { return const_reverse_iterator(begin()); }
+			const_reverse_iterator crend() const noexcept { return rend(); }
+
+		private:
+			container_type keys {};				//sorted and unique elements
+			key_compare    cmp  {};				//element comparison function
+	};
+
+	template<class Key, class Compare, class KeyContainer>
+	bool operator == (const flat_set<Key, Compare, KeyContainer>& lhs, const flat_set<Key, Compare, KeyContainer>& rhs)
+	{
+		return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+
+	template<class Key, class Compare, class KeyContainer>
+	bool operator != (const flat_set<Key, Compare, KeyContainer>& lhs, const flat_set<Key, Compare, KeyContainer>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template<class Key, class Compare, class KeyContainer>
+	bool operator < (const flat_set<Key, Compare, KeyContainer>& lhs, const flat_set<Key, Compare, KeyContainer>& rhs)
+	{
+		return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+/*
+ *	map data container with range aggregates (sum / min / max of mapped values over a key range) in O(log n)
+ */
+
+#include "map.h"
+
+namespace cust					//customized / non-standard
+{
+	//augmentation policy: sum of the mapped values
+	template<class Key, class T>
+	struct range_sum
+	{
+		using summary_type = T;
+
+		static summary_type identity()
+		{
+			return summary_type {};
+		}
+
+		static summary_type lift(const std::pair<const Key, T>& value)
+		{
+			return value.second;
+		}
+
+		static summary_type combine(const summary_type& lhs, const summary_type& rhs)
+		{
+			return lhs + rhs;
+		}
+	};
+
+	//augmentation policy: min of the mapped values (pointer pointing to the min mapped value, nullptr if no element)
+	template<class Key, class T, class Compare = std::less<T>>
+	struct range_min
+	{
+		using summary_type = const T*;
+
+		static summary_type identity() noexcept
+		{
+			return nullptr;
+		}
+
+		static summary_type lift(const std::pair<const Key, T>& value) noexcept
+		{
+			return std::addressof(value.second);
+		}
+
+		static summary_type combine(summary_type lhs, summary_type rhs)
+		{
+			return lhs == nullptr ? rhs : (rhs == nullptr || !Compare{}(*rhs, *lhs) ? lhs : rhs);
+		}
+	};
+
+	//augmentation policy: max of the mapped values (pointer pointing to the max mapped value, nullptr if no element)
+	template<class Key, class T, class Compare = std::less<T>>
+	struct range_max
+	{
+		using summary_type = const T*;
+
+		static summary_type identity() noexcept
+		{
+			return nullptr;
+		}
+
+		static summary_type lift(const std::pair<const Key, T>& value) noexcept
+		{
+			return std::addressof(value.second);
+		}
+
+		static summary_type combine(summary_type lhs, summary_type rhs)
+		{
+			return lhs == nullptr ? rhs : (rhs == nullptr || !Compare{}(*lhs, *rhs) ? lhs : rhs);
+		}
+	};
+
+	/*
+	 *	map data container keeping a summary of the mapped values of each subtree
+	 *
+	 *	mapped values must be modified by insert_or_assign(), or update() must be called after modifying them through an iterator
+	 */
+	template<class Key, class T, class Augment = range_sum<Key, T>, class Compare = std::less<Key>, class Allocator = std::allocator<std::pair<const Key, T>>>
+	class augmented_map : public bbst_container<Key, std::pair<const Key, T>, ComPair<Key, T, Compare>, Allocator, AVL_tree<std::pair<const Key, T>, ComPair<Key, T, Compare>, Allocator, Augment>>
+	{
+		public:
+			using base_type      = bbst_container<Key, std::pair<const Key, T>, ComPair<Key, T, Compare>, Allocator, AVL_tree<std::pair<const Key, T>, ComPair<Key, T, Compare>, Allocator, Augment>>;
+			using key_type       = typename base_type::key_type;
+			using value_type     = typename base_type::value_type;
+			using mapped_type    = T;
+			using key_compare    = Compare;
+			using iterator       = typename base_type::iterator;
+			using const_iterator = typename base_type::const_iterator;
+			using summary_type   = typename Augment::summary_type;
+
+			using base_type::base_type;
+
+			//returns the function object that compares the keys
+			key_compare key_comp() const
+			{
+				return key_compare{};
+			}
+
+			//access a specified element with bounds checking
+			const mapped_type& at(const key_type& key) const
+			{
+				auto ptr { this->bbst.find(key) };
+
+				if (ptr == nullptr)
+					throw std::out_of_range("invalid element access: no such key");
+
+				return ptr->value.second;
+			}
+
+			//inserts an element or assigns to the mapped value of the existing element, and updates the summaries
+			template<class M>
+			std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+			{
+				auto ptr { this->bbst.find(key) };
+
+				if (ptr == nullptr)
+					return this->bbst.insert(value_type(key, std::forward<M>(obj)));
+
+				ptr->value.second = std::forward<M>(obj);
+
+				this->bbst.update_summary(ptr);
+
+				return { ptr, false };
+			}
+
+			//updates the summaries after the mapped value of the element at pos is modified through an iterator
+			void update(const_iterator pos)
+			{
+				if (pos != this->cend())
+					this->bbst.update_summary(this->bbst.find(pos->first));
+			}
+
+			//gets the summary of the mapped values of all elements
+			summary_type accumulate() const
+			{
+				return this->bbst.summary();
+			}
+
+			//gets the summary of the mapped values of the elements with their keys in the range [lo, hi)
+			summary_type accumulate(const key_type& lo, const key_type& hi) const
+			{
+				return this->bbst.accumulate(lo, hi);
+			}
+	};
+
+	//map data container with range sum queries
+	template<class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<std::pair<const Key, T>>>
+	using range_sum_map = augmented_map<Key, T, range_sum<Key, T>, Compare, Allocator>;
+}
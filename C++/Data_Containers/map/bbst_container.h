@@ -4,7 +4,11 @@
  *	balanced binary search tree (BBST) container
  */
 
+#include <algorithm>
+#include <iterator>
 #include "AVL_tree.h"
+#include "splay_tree.h"
+#include "treap.h"
 #include "iterator_base.h"
 
 namespace cust					//customized / non-standard
@@ -13,7 +17,7 @@ namespace cust					//customized / non-standard
 	class bbst_iterator : public container_iterator<std::remove_const_t<T>, NodeTy>
 	{
 		//friend class forward declaration
-		template<class, class, class, class>
+		template<class, class, class, class, class>
 		friend class bbst_container;
 
 		private:
@@ -69,7 +73,145 @@ namespace cust					//customized / non-standard
 			}
 	};
 
-	template<class KeyTy, class ValTy, class Compare = std::less<ValTy>, class Allocator = std::allocator<ValTy>>
+	/*
+	 *	forward cursor for a fast ordered scan, keeps the pending ancestors in a fixed-size stack
+	 *
+	 *	a step pops the current node and pushes the left spine of its right subtree, no parent pointer is climbed
+	 *	(about n pointer chases for a full scan instead of 2n), the cursor is invalidated by any insertion or removal
+	 */
+	template<class T, template<class...> class NodeTy>
+	class bbst_cursor
+	{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type        = std::remove_const_t<T>;
+			using difference_type   = std::ptrdiff_t;
+			using pointer           = T*;
+			using reference         = T&;
+			using node_type         = NodeTy<std::remove_const_t<T>>;
+			using node_pointer      = node_type*;
+
+			//the height of an AVL tree is less than 1.45 * log2(n + 2), 64 levels are far beyond any tree that fits in memory
+			static constexpr std::size_t max_height { 64 };
+
+			bbst_cursor() noexcept = default;
+
+			//constructor with the range [first, last) of nodes of the same tree (last is the pseudo head node for the end)
+			bbst_cursor(node_pointer first, node_pointer last) noexcept : last { last }
+			{
+				if (first == nullptr || first == last || first->parent == first)
+					return;
+
+				//the pending ancestors are those whose left subtree holds first, the root of the tree is the child of the pseudo head
+				stack[top++] = first;
+
+				for (auto child { first }, ptr { first->parent }; ptr->parent != ptr; child = ptr, ptr = ptr->parent)
+				{
+					if (ptr->left == child)
+						stack[top++] = ptr;
+				}
+
+				std::reverse(stack, stack + top);
+			}
+
+			reference operator * () const noexcept
+			{
+				return stack[top - 1]->value;
+			}
+
+			pointer operator -> () const noexcept
+			{
+				return std::addressof(stack[top - 1]->value);
+			}
+
+			auto& operator ++ () noexcept
+			{
+				auto ptr { stack[--top] };
+
+				for (ptr = ptr->right; ptr != nullptr; ptr = ptr->left)
+					stack[top++] = ptr;
+
+				if (0 < top && stack[top - 1] == last)
+					top = 0;
+
+				return *this;
+			}
+
+			auto operator ++ (int) noexcept
+			{
+				auto tmp { *this };
+
+				operator++();
+
+				return tmp;
+			}
+
+			bool operator == (const bbst_cursor& other) const noexcept
+			{
+				return get_node() == other.get_node();
+			}
+
+			bool operator != (const bbst_cursor& other) const noexcept
+			{
+				return !(*this == other);
+			}
+
+			//the end of the scan
+			bool operator == (std::default_sentinel_t) const noexcept
+			{
+				return top == 0;
+			}
+
+		private:
+			//gets the node the cursor points to (nullptr for the end)
+			node_pointer get_node() const noexcept
+			{
+				return top == 0 ? nullptr : stack[top - 1];
+			}
+
+			node_pointer stack[max_height] {};		//the current node (on the top) and the ancestors to visit after it
+			std::size_t  top  { 0 };
+			node_pointer last { nullptr };			//the node to stop at
+	};
+
+	//checks if the height of the tree is O(log n) in the worst case (the scan cursor keeps the ancestors in a fixed stack)
+	template<class Tree>
+	inline constexpr bool is_height_bounded_v { true };
+
+	template<class T, class Compare, class Allocator>
+	inline constexpr bool is_height_bounded_v<splay_tree<T, Compare, Allocator>> { false };
+
+	template<class T, class Compare, class Allocator>
+	inline constexpr bool is_height_bounded_v<treap<T, Compare, Allocator>> { false };
+
+	//a range of bbst_cursor for the range-based for loop, e.g. for (auto& elem : container.scan())
+	template<class Cursor>
+	class bbst_scan
+	{
+		public:
+			bbst_scan(Cursor first) noexcept : first { first }
+			{
+			}
+
+			Cursor begin() const noexcept
+			{
+				return first;
+			}
+
+			std::default_sentinel_t end() const noexcept
+			{
+				return std::default_sentinel;
+			}
+
+		private:
+			Cursor first;
+	};
+
+	/*
+	 *	Tree: the balanced binary search tree as the implementation of the container
+	 *	      (e.g. an AVL tree with an augmentation policy, a splay_tree or a treap)
+	 */
+	template<class KeyTy, class ValTy, class Compare = std::less<ValTy>, class Allocator = std::allocator<ValTy>, class Tree = AVL_tree<ValTy, Compare, Allocator>>
 	class bbst_container
 	{
 		public:
@@ -85,13 +227,15 @@ namespace cust					//customized / non-standard
 			using pointer         = value_type*;
 			using const_pointer   = const value_type*;
 
-			using iterator               = bbst_iterator<std::conditional_t<std::is_same_v<key_type, value_type>, std::add_const_t<value_type>, value_type>, AVL_tree_node>;
-			using const_iterator         = bbst_iterator<const value_type, AVL_tree_node>;
+			using iterator               = bbst_iterator<std::conditional_t<std::is_same_v<key_type, value_type>, std::add_const_t<value_type>, value_type>, Tree::template node_template>;
+			using const_iterator         = bbst_iterator<const value_type, Tree::template node_template>;
 			using reverse_iterator       = std::reverse_iterator<iterator>;
 			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+			using cursor                 = bbst_cursor<std::conditional_t<std::is_same_v<key_type, value_type>, std::add_const_t<value_type>, value_type>, Tree::template node_template>;
+			using const_cursor           = bbst_cursor<const value_type, Tree::template node_template>;
 
-		private:
-			using impl_type    = AVL_tree<value_type, value_compare, allocator_type>;
+		protected:
+			using impl_type    = Tree;
 			using node_type    = typename impl_type::node_type;
 			using node_pointer = typename impl_type::node_pointer;
 
@@ -201,6 +345,17 @@ namespace cust					//customized / non-standard
 				return { pr.first , pr.second };
 			}
 
+			//inserts an element into the container near the hint position, falls back to a search from the root if the hint is wrong
+			iterator insert(const_iterator hint, const value_type& value)
+			{
+				return bbst.insert(hint.ptr, value).first;
+			}
+
+			iterator insert(const_iterator hint, value_type&& value)
+			{
+				return bbst.insert(hint.ptr, std::move(value)).first;
+			}
+
 			//inserts a range of elements [first, last) into the container
 			template<class InputIter>
 			void insert(InputIter first, InputIter last)
@@ -214,6 +369,20 @@ namespace cust					//customized / non-standard
 				bbst.insert(init);
 			}
 
+			//replaces the contents with the range [first, last) sorted by the keys without equivalent ones, O(n)
+			template<class ForwardIter>
+			void assign_sorted(ForwardIter first, ForwardIter last)
+			{
+				bbst.assign_sorted(first, last);
+			}
+
+			//replaces the contents with n elements sorted by the keys without equivalent ones, each returned by gen(), O(n)
+			template<class Gen>
+			void assign_sorted(size_type n, Gen gen)
+			{
+				bbst.assign_sorted(n, gen);
+			}
+
 			//inserts an element into the container with its value constructed in-place
 			template<class... Args>
 			std::pair<iterator, bool> emplace(Args&&... args)
@@ -223,12 +392,25 @@ namespace cust					//customized / non-standard
 				return { (pr.first) , pr.second };
 			}
 
+			//inserts an element into the container with its value constructed in-place near the hint position
+			template<class... Args>
+			iterator emplace_hint(const_iterator hint, Args&&... args)
+			{
+				return bbst.emplace_hint(hint.ptr, std::forward<Args>(args)...).first;
+			}
+
 			//removes specified elements from the container
 			iterator erase(const_iterator pos)
 			{
 				return pos == cend() ? pos : bbst.erase(pos.ptr);
 			}
 
+			//removes the elements in the range [first, last) by split and join in O(log n + k)
+			iterator erase(const_iterator first, const_iterator last)
+			{
+				return bbst.erase(first.ptr, last.ptr);
+			}
+
 			size_type erase(const key_type& key)
 			{
 				auto ptr { bbst.find(key) };
@@ -238,18 +420,88 @@ namespace cust					//customized / non-standard
 				return ptr == nullptr ? 0 : 1;
 			}
 
+			template<class K, class C = Compare, class = typename C::is_transparent, class = std::enable_if_t<!std::is_convertible_v<K&&, iterator> && !std::is_convertible_v<K&&, const_iterator>>>
+			size_type erase(K&& key)
+			{
+				auto ptr { bbst.find(key) };
+
+				bbst.erase(ptr);
+
+				return ptr == nullptr ? 0 : 1;
+			}
+
 			//exchanges the contents of the container with those of other
 			void swap(bbst_container& other) noexcept
 			{
 				bbst.swap(other.bbst);
 			}
 
+			/*
+			 *	set operations by split and join, O(m log(n / m + 1)) for the sizes m <= n
+			 *
+			 *	the nodes of other are moved into the container (no allocation and no copy), other becomes empty
+			 */
+
+			//merges the elements of other, the elements of the container are kept for the equivalent keys
+			void union_with(bbst_container& other)
+			{
+				bbst.union_with(other.bbst);
+			}
+
+			//keeps the elements with the keys found in other
+			void intersection_with(bbst_container& other)
+			{
+				bbst.intersection_with(other.bbst);
+			}
+
+			//removes the elements with the keys found in other
+			void difference_with(bbst_container& other)
+			{
+				bbst.difference_with(other.bbst);
+			}
+
+			//keeps the elements with the keys found in exactly one of the container and other
+			void symmetric_difference_with(bbst_container& other)
+			{
+				bbst.symmetric_difference_with(other.bbst);
+			}
+
 			//returns the number of elements with the same key
 			size_type count(const key_type& key) const noexcept
 			{
 				return find(key) == end() ? 0 : 1;
 			}
 
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			size_type count(const K& key) const
+			{
+				return find(key) == end() ? 0 : 1;
+			}
+
+			//returns the number of elements with the keys in the range [lo, hi), O(log n) with counted_bbst_container
+			size_type count_range(const key_type& lo, const key_type& hi) const
+			{
+				return bbst.count_range(lo, hi);
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			size_type count_range(const K& lo, const K& hi) const
+			{
+				return bbst.count_range(lo, hi);
+			}
+
+			//gets the statistics of the tree (see tree_stats and instrumented_bbst_container)
+			const auto& stats() const noexcept
+			{
+				return bbst.stats();
+			}
+
+			//resets the statistics of the tree except the counters of allocations and deallocations
+			void reset_stats() noexcept
+			{
+				bbst.reset_stats();
+			}
+
 			//finds the element with the same key
 			iterator find(const key_type& key)
 			{
@@ -265,12 +517,35 @@ namespace cust					//customized / non-standard
 				return ptr == nullptr ? cend() : ptr;
 			}
 
+			//finds the element with the key equivalent to the function argument (without constructing a key_type object)
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			iterator find(const K& key)
+			{
+				auto ptr { bbst.find(key) };
+
+				return ptr == nullptr ? end() : ptr;
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			const_iterator find(const K& key) const
+			{
+				auto ptr { bbst.find(key) };
+
+				return ptr == nullptr ? cend() : ptr;
+			}
+
 			//checks if there is an element with the same key
 			bool contains(const key_type& key) const
 			{
 				return 0 < count(key);
 			}
 
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			bool contains(const K& key) const
+			{
+				return 0 < count(key);
+			}
+
 			//finds the first element with its key that is not less than the function argument
 			iterator lower_bound(const key_type& key)
 			{
@@ -286,6 +561,22 @@ namespace cust					//customized / non-standard
 				return ptr == nullptr ? cend() : ptr;
 			}
 
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			iterator lower_bound(const K& key)
+			{
+				auto ptr { bbst.lower_bound(key) };
+
+				return ptr == nullptr ? end() : ptr;
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			const_iterator lower_bound(const K& key) const
+			{
+				auto ptr { bbst.lower_bound(key) };
+
+				return ptr == nullptr ? cend() : ptr;
+			}
+
 			//finds the first element with its key that is greater than the function argument
 			iterator upper_bound(const key_type& key)
 			{
@@ -301,6 +592,45 @@ namespace cust					//customized / non-standard
 				return ptr == nullptr ? cend() : ptr;
 			}
 
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			iterator upper_bound(const K& key)
+			{
+				auto ptr { bbst.upper_bound(key) };
+
+				return ptr == nullptr ? end() : ptr;
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			const_iterator upper_bound(const K& key) const
+			{
+				auto ptr { bbst.upper_bound(key) };
+
+				return ptr == nullptr ? cend() : ptr;
+			}
+
+			//returns the range of elements with the same key, [lower_bound, upper_bound)
+			std::pair<iterator, iterator> equal_range(const key_type& key)
+			{
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+			{
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			std::pair<iterator, iterator> equal_range(const K& key)
+			{
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+			{
+				return { lower_bound(key), upper_bound(key) };
+			}
+
 			//returns an iterator to the beginning
 			iterator begin() noexcept
 			{
@@ -351,42 +681,221 @@ namespace cust					//customized / non-standard
 
 			const_reverse_iterator crend() const noexcept { return rend(); }
 
+			/*
+			 *	fast ordered scan of all elements, or of the elements in [first, last), by a cursor with an explicit stack
+			 *
+			 *	e.g. for (auto& elem : container.scan()) or for (auto& elem : container.scan(lower_bound(lo), lower_bound(hi)))
+			 *	(only for the trees of bounded height, not for splay_tree or treap)
+			 */
+			bbst_scan<cursor> scan() noexcept requires is_height_bounded_v<Tree>
+			{
+				return cursor(begin().ptr, end().ptr);
+			}
+
+			bbst_scan<const_cursor> scan() const noexcept requires is_height_bounded_v<Tree>
+			{
+				return const_cursor(begin().ptr, end().ptr);
+			}
+
+			bbst_scan<cursor> scan(const_iterator first, const_iterator last) noexcept requires is_height_bounded_v<Tree>
+			{
+				return cursor(first.ptr, last.ptr);
+			}
+
+			bbst_scan<const_cursor> scan(const_iterator first, const_iterator last) const noexcept requires is_height_bounded_v<Tree>
+			{
+				return const_cursor(first.ptr, last.ptr);
+			}
+
 		protected:
 			impl_type bbst {};
 	};
 
-	template<class KeyTy, class ValTy, class Compare, class Allocator>
-	bool operator == (const bbst_container<KeyTy, ValTy, Compare, Allocator>& lhs, const bbst_container<KeyTy, ValTy, Compare, Allocator>& rhs)
+	//bbst_container with the size of each subtree kept in the nodes (count_range in O(log n))
+	template<class KeyTy, class ValTy, class Compare = std::less<ValTy>, class Allocator = std::allocator<ValTy>>
+	using counted_bbst_container = bbst_container<KeyTy, ValTy, Compare, Allocator, AVL_tree<ValTy, Compare, Allocator, subtree_size>>;
+
+	//bbst_container on an AVL tree which counts comparisons, rotations, allocations and the lengths of the search paths (tree_stats)
+	template<class KeyTy, class ValTy, class Compare = std::less<ValTy>, class Allocator = std::allocator<ValTy>>
+	using instrumented_bbst_container = bbst_container<KeyTy, ValTy, Compare, Allocator, AVL_tree<ValTy, Compare, Allocator, no_augment, tree_stats>>;
+
+	//bbst_container on a splay tree (recently accessed elements near the root, for skewed lookups, no concurrent readers)
+	template<class KeyTy, class ValTy, class Compare = std::less<ValTy>, class Allocator = std::allocator<ValTy>>
+	using splay_bbst_container = bbst_container<KeyTy, ValTy, Compare, Allocator, splay_tree<ValTy, Compare, Allocator>>;
+
+	//bbst_container on a treap (expected O(log n) height, fewer rotations than an AVL tree on insertion and removal)
+	template<class KeyTy, class ValTy, class Compare = std::less<ValTy>, class Allocator = std::allocator<ValTy>>
+	using treap_bbst_container = bbst_container<KeyTy, ValTy, Compare, Allocator, treap<ValTy, Compare, Allocator>>;
+
+	/*
+	 *	balanced binary search tree container with equivalent keys (for multimap and multiset)
+	 *
+	 *	a new element is inserted after the elements with the equivalent key (equivalent elements keep the order of insertion),
+	 *	the size of each subtree is kept in the nodes by default, so count() and count_range() are O(log n)
+	 */
+	template<class KeyTy, class ValTy, class Compare = std::less<ValTy>, class Allocator = std::allocator<ValTy>, class Tree = AVL_tree<ValTy, Compare, Allocator, subtree_size>>
+	class bbst_multicontainer : public bbst_container<KeyTy, ValTy, Compare, Allocator, Tree>
+	{
+		public:
+			using base_type      = bbst_container<KeyTy, ValTy, Compare, Allocator, Tree>;
+			using key_type       = typename base_type::key_type;
+			using value_type     = typename base_type::value_type;
+			using size_type      = typename base_type::size_type;
+			using iterator       = typename base_type::iterator;
+			using const_iterator = typename base_type::const_iterator;
+
+			//default constructor
+			bbst_multicontainer() = default;
+
+			//range constructor
+			template<class InputIter>
+			bbst_multicontainer(InputIter first, InputIter last)
+			{
+				insert(first, last);
+			}
+
+			//constructor with initializer list
+			bbst_multicontainer(std::initializer_list<value_type> init)
+			{
+				insert(init);
+			}
+
+			//assignment with initializer list
+			bbst_multicontainer& operator = (std::initializer_list<value_type> init)
+			{
+				this->clear();
+
+				insert(init);
+
+				return *this;
+			}
+
+			//inserts an element into the container after the elements with the equivalent key (with copy semantics)
+			iterator insert(const value_type& value)
+			{
+				return this->bbst.insert_equal(value);
+			}
+
+			//inserts an element into the container after the elements with the equivalent key (with move semantics)
+			iterator insert(value_type&& value)
+			{
+				return this->bbst.insert_equal(std::move(value));
+			}
+
+			//inserts an element into the container, the hint is not used (the position among the equivalent elements is the last one)
+			iterator insert(const_iterator, const value_type& value)
+			{
+				return insert(value);
+			}
+
+			iterator insert(const_iterator, value_type&& value)
+			{
+				return insert(std::move(value));
+			}
+
+			//inserts a range of elements [first, last) into the container
+			template<class InputIter>
+			void insert(InputIter first, InputIter last)
+			{
+				this->bbst.insert_equal(first, last);
+			}
+
+			//inserts the elements of the initializer list into the container
+			void insert(std::initializer_list<value_type> init)
+			{
+				insert(init.begin(), init.end());
+			}
+
+			//inserts an element into the container with its value constructed in-place
+			template<class... Args>
+			iterator emplace(Args&&... args)
+			{
+				return this->bbst.emplace_equal(std::forward<Args>(args)...);
+			}
+
+			//inserts an element into the container with its value constructed in-place, the hint is not used
+			template<class... Args>
+			iterator emplace_hint(const_iterator, Args&&... args)
+			{
+				return emplace(std::forward<Args>(args)...);
+			}
+
+			//removes specified elements from the container
+			using base_type::erase;
+
+			//removes all elements with the same key by split and join in O(log n + k), returns the number of elements removed
+			size_type erase(const key_type& key)
+			{
+				auto [first, last] = this->equal_range(key);
+				auto n { this->size() };
+
+				this->erase(first, last);
+
+				return n - this->size();
+			}
+
+			template<class K, class C = typename base_type::key_compare, class = typename C::is_transparent, class = std::enable_if_t<!std::is_convertible_v<K&&, iterator> && !std::is_convertible_v<K&&, const_iterator>>>
+			size_type erase(K&& key)
+			{
+				auto [first, last] = this->equal_range(key);
+				auto n { this->size() };
+
+				this->erase(first, last);
+
+				return n - this->size();
+			}
+
+			//returns the number of elements with the same key
+			size_type count(const key_type& key) const
+			{
+				return this->bbst.count(key);
+			}
+
+			template<class K, class C = typename base_type::key_compare, class = typename C::is_transparent>
+			size_type count(const K& key) const
+			{
+				return this->bbst.count(key);
+			}
+
+			//the set operations split the trees by the keys, they are not for equivalent keys
+			void union_with(bbst_multicontainer&)                = delete;
+			void intersection_with(bbst_multicontainer&)         = delete;
+			void difference_with(bbst_multicontainer&)           = delete;
+			void symmetric_difference_with(bbst_multicontainer&) = delete;
+	};
+
+	template<class KeyTy, class ValTy, class Compare, class Allocator, class Tree>
+	bool operator == (const bbst_container<KeyTy, ValTy, Compare, Allocator, Tree>& lhs, const bbst_container<KeyTy, ValTy, Compare, Allocator, Tree>& rhs)
 	{
 		return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
 	}
 
-	template<class KeyTy, class ValTy, class Compare, class Allocator>
-	bool operator != (const bbst_container<KeyTy, ValTy, Compare, Allocator>& lhs, const bbst_container<KeyTy, ValTy, Compare, Allocator>& rhs)
+	template<class KeyTy, class ValTy, class Compare, class Allocator, class Tree>
+	bool operator != (const bbst_container<KeyTy, ValTy, Compare, Allocator, Tree>& lhs, const bbst_container<KeyTy, ValTy, Compare, Allocator, Tree>& rhs)
 	{
 		return !(lhs == rhs);
 	}
 
-	template<class KeyTy, class ValTy, class Compare, class Allocator>
-	bool operator < (const bbst_container<KeyTy, ValTy, Compare, Allocator>& lhs, const bbst_container<KeyTy, ValTy, Compare, Allocator>& rhs)
+	template<class KeyTy, class ValTy, class Compare, class Allocator, class Tree>
+	bool operator < (const bbst_container<KeyTy, ValTy, Compare, Allocator, Tree>& lhs, const bbst_container<KeyTy, ValTy, Compare, Allocator, Tree>& rhs)
 	{
 		return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 	}
 
-	template<class KeyTy, class ValTy, class Compare, class Allocator>
-	bool operator <= (const bbst_container<KeyTy, ValTy, Compare, Allocator>& lhs, const bbst_container<KeyTy, ValTy, Compare, Allocator>& rhs)
+	template<class KeyTy, class ValTy, class Compare, class Allocator, class Tree>
+	bool operator <= (const bbst_container<KeyTy, ValTy, Compare, Allocator, Tree>& lhs, const bbst_container<KeyTy, ValTy, Compare, Allocator, Tree>& rhs)
 	{
 		return !(rhs < lhs);
 	}
 
-	template<class KeyTy, class ValTy, class Compare, class Allocator>
-	bool operator > (const bbst_container<KeyTy, ValTy, Compare, Allocator>& lhs, const bbst_container<KeyTy, ValTy, Compare, Allocator>& rhs)
+	template<class KeyTy, class ValTy, class Compare, class Allocator, class Tree>
+	bool operator > (const bbst_container<KeyTy, ValTy, Compare, Allocator, Tree>& lhs, const bbst_container<KeyTy, ValTy, Compare, Allocator, Tree>& rhs)
 	{
 		return rhs < lhs;
 	}
 
-	template<class KeyTy, class ValTy, class Compare, class Allocator>
-	bool operator >= (const bbst_container<KeyTy, ValTy, Compare, Allocator>& lhs, const bbst_container<KeyTy, ValTy, Compare, Allocator>& rhs)
+	template<class KeyTy, class ValTy, class Compare, class Allocator, class Tree>
+	bool operator >= (const bbst_container<KeyTy, ValTy, Compare, Allocator, Tree>& lhs, const bbst_container<KeyTy, ValTy, Compare, Allocator, Tree>& rhs)
 	{
 		return !(lhs < rhs);
 	}
@@ -0,0 +1,1013 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <iterator>
+#include <initializer_list>
+#include <functional>
+
+namespace cust					//customized / non-standard
+{
+	/*
+	 *	B-tree node, elements are stored in a contiguous array of each node
+	 *
+	 *	NodeSize: the size of a leaf node in bytes (e.g. 256 ~ 4096 bytes)
+	 */
+	template<class T, std::size_t NodeSize>
+	struct btree_node
+	{
+		using value_type   = T;
+		using size_type    = std::uint16_t;
+		using node_pointer = btree_node*;
+
+		//header: parent pointer, position, count and leaf flag
+		static constexpr std::size_t header_size = sizeof(void*) + 2 * sizeof(size_type) + sizeof(bool);
+
+		//max number of elements of a node (at least 3 elements)
+		static constexpr size_type max_count = static_cast<size_type>(NodeSize < header_size + 3 * sizeof(T) ? 3 : (NodeSize - header_size) / sizeof(T) < 0xFFFE ? (NodeSize - header_size) / sizeof(T) : 0xFFFE);
+
+		//min number of elements of a non-root node
+		static constexpr size_type min_count = (max_count - 1) / 2;
+
+		//gets the i-th child node of an internal node
+		static node_pointer& child(node_pointer ptr, std::size_t i) noexcept;
+
+		//gets the i-th element of the node
+		value_type* slot(size_type i) noexcept
+		{
+			return std::launder(reinterpret_cast<value_type*>(slots)) + i;
+		}
+
+		value_type& value(size_type i) noexcept
+		{
+			return *slot(i);
+		}
+
+		node_pointer parent   { nullptr };			//pointer pointing to parent node
+		size_type    position { 0 };				//index of the node in the children of its parent node
+		size_type    count    { 0 };				//the number of elements of the node
+		bool         leaf     { true };				//is a leaf node
+
+		alignas(value_type) unsigned char slots[max_count * sizeof(value_type)];		//(uninitialized) storage of elements
+	};
+
+	//B-tree internal node, a node with (count + 1) children
+	template<class T, std::size_t NodeSize>
+	struct btree_internal_node : public btree_node<T, NodeSize>
+	{
+		using base_type    = btree_node<T, NodeSize>;
+		using node_pointer = typename base_type::node_pointer;
+
+		node_pointer children[base_type::max_count + 1] {};		//pointers pointing to child nodes
+	};
+
+	template<class T, std::size_t NodeSize>
+	auto btree_node<T, NodeSize>::child(node_pointer ptr, std::size_t i) noexcept -> node_pointer&
+	{
+		return static_cast<btree_internal_node<T, NodeSize>*>(ptr)->children[i];
+	}
+
+	/*
+	 *	B-tree iterator, points to the pos-th element of a node
+	 *
+	 *	the end iterator points to the position after the last element of the rightmost leaf node
+	 */
+	template<class T, class NodeTy>
+	class btree_iterator
+	{
+		//friend class forward declaration
+		template<class, class, class, std::size_t>
+		friend class btree;
+
+		template<class, class>
+		friend class btree_iterator;
+
+		private:
+			using Ty = std::conditional_t<std::is_const_v<T>, std::remove_const_t<T>, const T>;
+
+		public:
+			using iterator_category = std::bidirectional_iterator_tag;
+			using value_type        = std::remove_const_t<T>;
+			using difference_type   = std::ptrdiff_t;
+			using pointer           = T*;
+			using reference         = T&;
+			using node_type         = NodeTy;
+			using node_pointer      = node_type*;
+			using size_type         = typename node_type::size_type;
+
+			btree_iterator() noexcept = default;
+
+			btree_iterator(node_pointer n, size_type p) noexcept : node { n }, pos { p }
+			{
+			}
+
+			reference operator * () const noexcept
+			{
+				return node->value(pos);
+			}
+
+			pointer operator -> () const noexcept
+			{
+				return std::addressof(**this);
+			}
+
+			bool operator == (const btree_iterator& other) const noexcept
+			{
+				return node == other.node && pos == other.pos;
+			}
+
+			bool operator != (const btree_iterator& other) const noexcept
+			{
+				return !operator==(other);
+			}
+
+			auto& operator ++ () noexcept
+			{
+				if (node->leaf)
+				{
+					//climbs up when reaching the end of the leaf node
+					if (++pos == node->count)
+					{
+						auto n { node };
+						auto p { pos };
+
+						for ( ; p == n->count && n->parent != nullptr; )
+						{
+							p = n->position;
+							n = n->parent;
+						}
+
+						//stays at the end of the rightmost leaf node if there is no successor
+						if (p != n->count)
+						{
+							node = n;
+							pos  = p;
+						}
+					}
+				}
+				else
+				{
+					//the leftmost element of the right subtree
+					node = node_type::child(node, pos + 1);
+
+					for ( ; !node->leaf; node = node_type::child(node, 0));
+
+					pos = 0;
+				}
+
+				return *this;
+			}
+
+			auto operator ++ (int) noexcept
+			{
+				auto tmp { *this };
+
+				operator++();
+
+				return tmp;
+			}
+
+			auto& operator -- () noexcept
+			{
+				if (node->leaf)
+				{
+					//climbs up when reaching the beginning of the leaf node
+					for ( ; pos == 0 && node->parent != nullptr; )
+					{
+						pos  = node->position;
+						node = node->parent;
+					}
+
+					--pos;
+				}
+				else
+				{
+					//the rightmost element of the left subtree
+					node = node_type::child(node, pos);
+
+					for ( ; !node->leaf; node = node_type::child(node, node->count));
+
+					pos = node->count - 1;
+				}
+
+				return *this;
+			}
+
+			auto operator -- (int) noexcept
+			{
+				auto tmp { *this };
+
+				operator--();
+
+				return tmp;
+			}
+
+			//type conversion between iterator and const_iterator
+			operator btree_iterator<Ty, NodeTy>() const noexcept
+			{
+				return btree_iterator<Ty, NodeTy>(node, pos);
+			}
+
+		private:
+			node_pointer node { nullptr };			//pointer pointing to the node
+			size_type    pos  { 0 };				//index of the element in the node
+	};
+
+	//B-tree data structure, elements are unique
+	template<class T, class Compare = std::less<T>, class Allocator = std::allocator<T>, std::size_t NodeSize = 256>
+	class btree
+	{
+		public:
+			using value_type         = T;
+			using size_type          = std::size_t;
+			using difference_type    = std::ptrdiff_t;
+			using pointer            = value_type*;
+			using const_pointer      = const value_type*;
+			using reference          = value_type&;
+			using const_reference    = const value_type&;
+			using node_type          = btree_node<value_type, NodeSize>;
+			using internal_node_type = btree_internal_node<value_type, NodeSize>;
+			using node_pointer       = node_type*;
+			using allocator_type     = typename std::allocator_traits<Allocator>::template rebind_alloc<node_type>;
+			using iterator           = btree_iterator<value_type, node_type>;
+			using const_iterator     = btree_iterator<const value_type, node_type>;
+
+			//default constructor
+			btree() noexcept = default;
+
+			//copy constructor
+			btree(const btree& other) : impl { other.impl }
+			{
+				impl.root = copy_nodes(other.impl.root, nullptr);
+				impl.sz   = other.impl.sz;
+			}
+
+			//move constructor
+			btree(btree&& other) noexcept
+			{
+				swap(other);
+			}
+
+			//range constructor
+			template<class InputIter>
+			btree(InputIter first, InputIter last)
+			{
+				insert(first, last);
+			}
+
+			//constructor with initializer list
+			btree(std::initializer_list<value_type> init)
+			{
+				insert(init);
+			}
+
+			//destructor
+			~btree()
+			{
+				clear();
+			}
+
+			//copy assignment
+			btree& operator = (const btree& other)
+			{
+				if (this != &other)
+				{
+					clear();
+
+					impl.root = copy_nodes(other.impl.root, nullptr);
+					impl.sz   = other.impl.sz;
+				}
+
+				return *this;
+			}
+
+			//move assignment
+			btree& operator = (btree&& other) noexcept
+			{
+				clear();
+
+				swap(other);
+
+				return *this;
+			}
+
+			//assignment with initializer list
+			btree& operator = (std::initializer_list<value_type> init)
+			{
+				clear();
+
+				insert(init);
+
+				return *this;
+			}
+
+			//gets the number of elements of the tree
+			size_type size() const noexcept
+			{
+				return impl.sz;
+			}
+
+			//checks if the tree is empty
+			bool empty() const noexcept
+			{
+				return size() == 0;
+			}
+
+			//clears all elements of the tree
+			void clear() noexcept
+			{
+				clear(impl.root);
+
+				impl.root = nullptr;
+				impl.sz   = 0;
+			}
+
+			//inserts an element into the tree (with copy semantics)
+			std::pair<iterator, bool> insert(const value_type& value)
+			{
+				auto pr { find_location(value) };
+
+				return pr.second ? std::make_pair(insert_at(pr.first, value), true) : pr;
+			}
+
+			//inserts an element into the tree (with move semantics)
+			std::pair<iterator, bool> insert(value_type&& value)
+			{
+				auto pr { find_location(value) };
+
+				return pr.second ? std::make_pair(insert_at(pr.first, std::move(value)), true) : pr;
+			}
+
+			//inserts a range of elements [first, last) into the tree
+			template<class InputIter>
+			void insert(InputIter first, InputIter last)
+			{
+				for ( ; first != last; ++first)
+					insert(*first);
+			}
+
+			//inserts the elements of the initializer list into the tree
+			void insert(std::initializer_list<value_type> init)
+			{
+				insert(init.begin(), init.end());
+			}
+
+			//inserts an element into the tree with its value constructed in-place (and moved into the node)
+			template<class... Args>
+			std::pair<iterator, bool> emplace(Args&&... args)
+			{
+				static_assert(std::is_constructible_v<value_type, Args...>, "parameter types of function emplace() are not constructible to value_type");
+
+				return insert(value_type(std::forward<Args>(args)...));
+			}
+
+			/*
+			 *	removes the element at pos from the tree, returns the iterator following the removed element
+			 *
+			 *	an element in an internal node is replaced by its successor (the leftmost element of its right subtree),
+			 *	then an underflowing leaf node borrows an element from its sibling or merges with it
+			 */
+			iterator erase(const_iterator pos)
+			{
+				auto node { pos.node };
+				auto i    { pos.pos  };
+
+				if ( !node->leaf )
+				{
+					auto leaf { child(node, i + 1) };
+
+					for ( ; !leaf->leaf; leaf = child(leaf, 0));
+
+					destroy(node->slot(i));
+					relocate(node->slot(i), leaf->slot(0));
+
+					shift_left(leaf, 1, leaf->count);
+					--leaf->count;
+
+					//the successor now lives at (node, i)
+					cursor = iterator(node, i);
+
+					rebalance(leaf);
+				}
+				else
+				{
+					destroy(node->slot(i));
+
+					shift_left(node, i + 1, node->count);
+					--node->count;
+
+					cursor = iterator(node, i);
+
+					//the successor is in an ancestral node if the removed element was the last one of the leaf node
+					if (i == node->count)
+					{
+						auto n { node };
+						auto p { i };
+
+						for ( ; p == n->count && n->parent != nullptr; )
+						{
+							p = n->position;
+							n = n->parent;
+						}
+
+						cursor = p == n->count ? iterator() : iterator(n, p);
+					}
+
+					rebalance(node);
+				}
+
+				--impl.sz;
+
+				return cursor.node == nullptr ? end() : cursor;
+			}
+
+			iterator erase(iterator pos)
+			{
+				return erase(const_iterator(pos));
+			}
+
+			/*
+			 *	removes the elements in the range [first, last) from the tree, returns the iterator following the removed ones
+			 *
+			 *	an erase moves the elements around (last may be moved or freed), so the range is counted first, O(k log n)
+			 */
+			iterator erase(const_iterator first, const_iterator last)
+			{
+				auto k    { std::distance(first, last) };
+				auto iter { iterator(first.node, first.pos) };
+
+				for ( ; 0 < k; --k)
+					iter = erase(iter);
+
+				return iter;
+			}
+
+			//removes the element with the equivalent val from the tree
+			template<class Ty>
+			size_type erase(const Ty& val)
+			{
+				auto iter { find(val) };
+
+				if (iter == end())
+					return 0;
+
+				erase(iter);
+
+				return 1;
+			}
+
+			//exchanges the elements of the tree with those of other
+			void swap(btree& other) noexcept
+			{
+				std::swap(impl.root, other.impl.root);
+				std::swap(impl.sz,   other.impl.sz);
+			}
+
+			//finds the element with the equivalent val of the tree
+			template<class Ty>
+			iterator find(const Ty& val) const
+			{
+				auto pr { find_location(val) };
+
+				return pr.second ? end() : pr.first;
+			}
+
+			//checks if there is an element with the equivalent val of the tree
+			template<class Ty>
+			bool contains(const Ty& val) const
+			{
+				return find(val) != end();
+			}
+
+			//finds the first element with the key or value that is not less than val
+			template<class Ty>
+			iterator lower_bound(const Ty& val) const
+			{
+				auto& cmp { get_compare() };
+
+				return bound(val, [&cmp](const value_type& elem, const Ty& v) { return cmp(elem, v); });
+			}
+
+			//finds the first element with the key or value that is greater than val
+			template<class Ty>
+			iterator upper_bound(const Ty& val) const
+			{
+				auto& cmp { get_compare() };
+
+				return bound(val, [&cmp](const value_type& elem, const Ty& v) { return !cmp(v, elem); });
+			}
+
+			//returns an iterator to the first element
+			iterator begin() const noexcept
+			{
+				auto node { impl.root };
+
+				if (node == nullptr)
+					return iterator();
+
+				for ( ; !node->leaf; node = child(node, 0));
+
+				return iterator(node, 0);
+			}
+
+			//returns an iterator to the position after the last element
+			iterator end() const noexcept
+			{
+				auto node { impl.root };
+
+				if (node == nullptr)
+					return iterator();
+
+				for ( ; !node->leaf; node = child(node, node->count));
+
+				return iterator(node, node->count);
+			}
+
+			//gets the height of the tree (the number of levels), 0 if the tree is empty
+			size_type height() const noexcept
+			{
+				size_type h { 0 };
+
+				for (auto node { impl.root }; node != nullptr; node = node->leaf ? nullptr : child(node, 0))
+					++h;
+
+				return h;
+			}
+
+			//gets the allocator
+			allocator_type& get_allocator() noexcept
+			{
+				return impl;
+			}
+
+			const allocator_type& get_allocator() const noexcept
+			{
+				return impl;
+			}
+
+			//gets the compare function object
+			Compare& get_compare() noexcept
+			{
+				return impl;
+			}
+
+			const Compare& get_compare() const noexcept
+			{
+				return impl;
+			}
+
+		private:
+			using node_size_type          = typename node_type::size_type;
+			using internal_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<internal_node_type>;
+
+			static constexpr node_size_type max_count = node_type::max_count;
+			static constexpr node_size_type min_count = node_type::min_count;
+
+			//gets the i-th child node of an internal node
+			static node_pointer& child(node_pointer ptr, size_type i) noexcept
+			{
+				return node_type::child(ptr, i);
+			}
+
+			//sets the i-th child node of an internal node
+			static void set_child(node_pointer ptr, size_type i, node_pointer c) noexcept
+			{
+				child(ptr, i) = c;
+				c->parent     = ptr;
+				c->position   = static_cast<node_size_type>(i);
+			}
+
+			//adds a leaf / internal node
+			node_pointer new_node(bool is_leaf, node_pointer parent)
+			{
+				node_pointer ptr { nullptr };
+
+				if (is_leaf)
+				{
+					ptr = std::allocator_traits<allocator_type>::allocate(get_allocator(), 1);
+					::new (static_cast<void*>(ptr)) node_type();
+				}
+				else
+				{
+					internal_allocator_type alloc { get_allocator() };
+
+					ptr = ::new (static_cast<void*>(std::allocator_traits<internal_allocator_type>::allocate(alloc, 1))) internal_node_type();
+					ptr->leaf = false;
+				}
+
+				ptr->parent = parent;
+
+				return ptr;
+			}
+
+			//deletes a node (its elements must be destroyed or relocated already)
+			void delete_node(node_pointer ptr) noexcept
+			{
+				if (ptr->leaf)
+				{
+					ptr->~node_type();
+					std::allocator_traits<allocator_type>::deallocate(get_allocator(), ptr, 1);
+				}
+				else
+				{
+					internal_allocator_type alloc { get_allocator() };
+					auto                    iptr  { static_cast<internal_node_type*>(ptr) };
+
+					iptr->~internal_node_type();
+					std::allocator_traits<internal_allocator_type>::deallocate(alloc, iptr, 1);
+				}
+			}
+
+			//constructs an element in the uninitialized storage
+			template<class... Args>
+			void construct(pointer ptr, Args&&... args)
+			{
+				std::allocator_traits<allocator_type>::construct(get_allocator(), ptr, std::forward<Args>(args)...);
+			}
+
+			//destroys an element
+			void destroy(pointer ptr) noexcept
+			{
+				std::allocator_traits<allocator_type>::destroy(get_allocator(), ptr);
+			}
+
+			//moves an element to the uninitialized storage dst, and destroys the source element
+			void relocate(pointer dst, pointer src)
+			{
+				construct(dst, std::move(*src));
+				destroy(src);
+			}
+
+			//moves the elements [first, last) of the node one position to the left (the position first - 1 is uninitialized)
+			void shift_left(node_pointer ptr, size_type first, size_type last)
+			{
+				for ( ; first < last; ++first)
+					relocate(ptr->slot(first - 1), ptr->slot(first));
+			}
+
+			//moves the elements [first, last) of the node one position to the right (the position last is uninitialized)
+			void shift_right(node_pointer ptr, size_type first, size_type last)
+			{
+				for ( ; first < last; --last)
+					relocate(ptr->slot(last), ptr->slot(last - 1));
+			}
+
+			//moves the children [first, last] of an internal node by offset positions
+			void shift_children(node_pointer ptr, size_type first, size_type last, difference_type offset)
+			{
+				if (offset < 0)
+				{
+					for ( ; first <= last; ++first)
+						set_child(ptr, first + offset, child(ptr, first));
+				}
+				else
+				{
+					for (auto i { last + 1 }; first < i; --i)
+						set_child(ptr, i - 1 + offset, child(ptr, i - 1));
+				}
+			}
+
+			//copies the subtree rooted in the src node
+			node_pointer copy_nodes(node_pointer src, node_pointer parent)
+			{
+				if (src == nullptr)
+					return nullptr;
+
+				auto ptr { new_node(src->leaf, parent) };
+
+				ptr->position = src->position;
+
+				for ( ; ptr->count != src->count; ++ptr->count)
+					construct(ptr->slot(ptr->count), src->value(ptr->count));
+
+				if ( !src->leaf )
+				{
+					for (size_type i { 0 }; i <= src->count; ++i)
+						child(ptr, i) = copy_nodes(child(src, i), ptr);
+				}
+
+				return ptr;
+			}
+
+			//clears all elements of the subtree rooted in the ptr node
+			void clear(node_pointer ptr) noexcept
+			{
+				if (ptr != nullptr)
+				{
+					if ( !ptr->leaf )
+						for (size_type i { 0 }; i <= ptr->count; ++i)
+							clear(child(ptr, i));
+
+					for (size_type i { 0 }; i != ptr->count; ++i)
+						destroy(ptr->slot(i));
+
+					delete_node(ptr);
+				}
+			}
+
+			//finds the index of the first element of the node that is not less than val
+			template<class Ty, class Less>
+			static node_size_type lower_index(node_pointer ptr, const Ty& val, Less less)
+			{
+				node_size_type lo { 0 }, n { ptr->count };
+
+				for ( ; 0 < n; )
+				{
+					auto half { static_cast<node_size_type>(n / 2) };
+
+					if (less(ptr->value(lo + half), val))
+					{
+						lo = static_cast<node_size_type>(lo + half + 1);
+						n  = static_cast<node_size_type>(n - half - 1);
+					}
+					else
+						n = half;
+				}
+
+				return lo;
+			}
+
+			//finds the lower / upper bound, the last node on the path with an index in range is the bound
+			template<class Ty, class Less>
+			iterator bound(const Ty& val, Less less) const
+			{
+				iterator result { end() };
+
+				for (auto ptr { impl.root }; ptr != nullptr; )
+				{
+					auto i { lower_index(ptr, val, less) };
+
+					if (i != ptr->count)
+						result = iterator(ptr, i);
+
+					ptr = ptr->leaf ? nullptr : child(ptr, i);
+				}
+
+				return result;
+			}
+
+			/*
+			 *	finds the location / position to insert a new element according to its key or value
+			 *
+			 *	return value:
+			 *					(iterator pointing to the position in a leaf node to insert, true)
+			 *					(iterator pointing to the element with duplicate value,       false)
+			 */
+			template<class Ty>
+			std::pair<iterator, bool> find_location(const Ty& val) const
+			{
+				auto& cmp { get_compare() };
+				auto  ptr { impl.root };
+
+				if (ptr == nullptr)
+					return std::make_pair(iterator(), true);
+
+				for ( ; ; )
+				{
+					auto i { lower_index(ptr, val, [&cmp](const value_type& elem, const Ty& v) { return cmp(elem, v); }) };
+
+					if (i != ptr->count && !cmp(val, ptr->value(i)))
+						return std::make_pair(iterator(ptr, i), false);
+
+					if (ptr->leaf)
+						return std::make_pair(iterator(ptr, i), true);
+
+					ptr = child(ptr, i);
+				}
+			}
+
+			//inserts an element at the position of a leaf node, splits the node if it is full
+			template<class... Args>
+			iterator insert_at(iterator pos, Args&&... args)
+			{
+				auto ptr { pos.node };
+				auto i   { pos.pos  };
+
+				if (ptr == nullptr)
+					ptr = impl.root = new_node(true, nullptr);
+
+				if (ptr->count == max_count)
+				{
+					constexpr node_size_type mid { max_count / 2 };
+
+					auto right { split(ptr) };
+
+					if (mid < i)
+					{
+						ptr = right;
+						i   = static_cast<node_size_type>(i - mid - 1);
+					}
+				}
+
+				shift_right(ptr, i, ptr->count);
+				construct(ptr->slot(i), std::forward<Args>(args)...);
+				++ptr->count;
+
+				++impl.sz;
+
+				return iterator(ptr, i);
+			}
+
+			/*
+			 *	splits a full node, returns the new right sibling node
+			 *
+			 *	the first half stays in the node, the median moves up to the parent node and the second half moves to the new node
+			 */
+			node_pointer split(node_pointer ptr)
+			{
+				constexpr node_size_type mid { max_count / 2 };
+
+				//the root node grows a level
+				if (ptr->parent == nullptr)
+				{
+					impl.root = new_node(false, nullptr);
+
+					set_child(impl.root, 0, ptr);
+				}
+				else if (ptr->parent->count == max_count)
+					split(ptr->parent);
+
+				auto parent { ptr->parent };
+				auto p      { ptr->position };
+				auto right  { new_node(ptr->leaf, parent) };
+
+				//moves the second half to the new node
+				for (node_size_type i { mid + 1 }; i != max_count; ++i, ++right->count)
+					relocate(right->slot(right->count), ptr->slot(i));
+
+				if ( !ptr->leaf )
+					for (node_size_type i { mid + 1 }; i <= max_count; ++i)
+						set_child(right, i - mid - 1, child(ptr, i));
+
+				//moves the median to the parent node
+				shift_right(parent, p, parent->count);
+
+				if (p < parent->count)
+					shift_children(parent, p + 1, parent->count, 1);
+
+				relocate(parent->slot(p), ptr->slot(mid));
+				set_child(parent, p + 1, right);
+
+				++parent->count;
+
+				ptr->count = mid;
+
+				return right;
+			}
+
+			//fixes the underflow of the node and its ancestral nodes, the cursor follows the element it points to
+			void rebalance(node_pointer ptr)
+			{
+				for ( ; ptr != impl.root && ptr->count < min_count; )
+				{
+					auto parent { ptr->parent };
+					auto p      { ptr->position };
+					auto left   { 0 < p ? child(parent, p - 1) : nullptr };
+					auto right  { p < parent->count ? child(parent, p + 1) : nullptr };
+
+					if (left != nullptr && min_count < left->count)
+					{
+						borrow_from_left(parent, p - 1);
+						return;
+					}
+
+					if (right != nullptr && min_count < right->count)
+					{
+						borrow_from_right(parent, p);
+						return;
+					}
+
+					merge(parent, left != nullptr ? p - 1 : p);
+
+					ptr = parent;
+				}
+
+				//the root node shrinks a level
+				if (impl.root->count == 0)
+				{
+					auto old_root { impl.root };
+
+					impl.root = old_root->leaf ? nullptr : child(old_root, 0);
+
+					if (impl.root != nullptr)
+					{
+						impl.root->parent   = nullptr;
+						impl.root->position = 0;
+					}
+
+					delete_node(old_root);
+				}
+			}
+
+			//moves the last element of the k-th child to the parent node, and the k-th element of the parent node to the (k + 1)-th child
+			void borrow_from_left(node_pointer parent, size_type k)
+			{
+				auto left  { child(parent, k)     };
+				auto right { child(parent, k + 1) };
+
+				shift_right(right, 0, right->count);
+
+				if ( !right->leaf )
+					shift_children(right, 0, right->count, 1);
+
+				relocate(right->slot(0), parent->slot(k));
+				relocate(parent->slot(k), left->slot(left->count - 1));
+
+				if ( !right->leaf )
+					set_child(right, 0, child(left, left->count));
+
+				--left->count;
+				++right->count;
+
+				if (cursor.node == right)
+					++cursor.pos;
+				else if (cursor.node == parent && cursor.pos == k)
+					cursor = iterator(right, 0);
+				else if (cursor.node == left && cursor.pos == left->count)
+					cursor = iterator(parent, k);
+			}
+
+			//moves the first element of the (k + 1)-th child to the parent node, and the k-th element of the parent node to the k-th child
+			void borrow_from_right(node_pointer parent, size_type k)
+			{
+				auto left  { child(parent, k)     };
+				auto right { child(parent, k + 1) };
+
+				relocate(left->slot(left->count), parent->slot(k));
+				relocate(parent->slot(k), right->slot(0));
+
+				if ( !left->leaf )
+					set_child(left, left->count + 1, child(right, 0));
+
+				shift_left(right, 1, right->count);
+
+				if ( !right->leaf )
+					shift_children(right, 1, right->count, -1);
+
+				++left->count;
+				--right->count;
+
+				if (cursor.node == parent && cursor.pos == k)
+					cursor = iterator(left, left->count - 1);
+				else if (cursor.node == right)
+				{
+					if (cursor.pos == 0)
+						cursor = iterator(parent, k);
+					else
+						--cursor.pos;
+				}
+			}
+
+			//merges the (k + 1)-th child and the k-th element of the parent node into the k-th child
+			void merge(node_pointer parent, size_type k)
+			{
+				auto left  { child(parent, k)     };
+				auto right { child(parent, k + 1) };
+				auto lc    { left->count };
+
+				relocate(left->slot(lc), parent->slot(k));
+
+				for (node_size_type i { 0 }; i != right->count; ++i)
+					relocate(left->slot(lc + 1 + i), right->slot(i));
+
+				if ( !left->leaf )
+					for (node_size_type i { 0 }; i <= right->count; ++i)
+						set_child(left, lc + 1 + i, child(right, i));
+
+				left->count = static_cast<node_size_type>(lc + 1 + right->count);
+
+				shift_left(parent, k + 1, parent->count);
+				shift_children(parent, k + 2, parent->count, -1);
+
+				--parent->count;
+
+				if (cursor.node == parent)
+				{
+					if (cursor.pos == k)
+						cursor = iterator(left, lc);
+					else if (k < cursor.pos)
+						--cursor.pos;
+				}
+				else if (cursor.node == right)
+					cursor = iterator(left, static_cast<node_size_type>(lc + 1 + cursor.pos));
+
+				right->count = 0;
+
+				delete_node(right);
+			}
+
+			//implementation type
+			struct impl_type : public Compare, allocator_type
+			{
+				node_pointer root { nullptr };			//a pointer pointing to root node
+				size_type    sz   { 0 };				//the number of elements of the tree
+			};
+
+			impl_type impl   {};					//implementation of B-tree
+			iterator  cursor {};					//the element following the removed one during erase()
+	};
+}
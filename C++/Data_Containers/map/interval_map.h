@@ -0,0 +1,138 @@
+#pragma once
+
+/*
+ *	interval map data container (interval tree), keys are half-open intervals [lo, hi)
+ */
+
+#include "map.h"
+
+namespace cust					//customized / non-standard
+{
+	//Function object to compare intervals lexicographically (by lower end, then by upper end)
+	template<class Key, class Compare = std::less<Key>>
+	struct interval_compare : public Compare
+	{
+		using interval_type = std::pair<Key, Key>;
+
+		constexpr bool operator () (const interval_type& lhs, const interval_type& rhs) const
+		{
+			const Compare& cmp { *this };
+
+			return cmp(lhs.first, rhs.first) || ( !cmp(rhs.first, lhs.first) && cmp(lhs.second, rhs.second) );
+		}
+	};
+
+	//augmentation policy: pointer pointing to the max upper end of the intervals of the subtree
+	template<class Key, class T, class Compare = std::less<Key>>
+	struct max_upper_end
+	{
+		using summary_type = const Key*;
+
+		static summary_type identity() noexcept
+		{
+			return nullptr;
+		}
+
+		static summary_type lift(const std::pair<const std::pair<Key, Key>, T>& value) noexcept
+		{
+			return std::addressof(value.first.second);
+		}
+
+		static summary_type combine(summary_type lhs, summary_type rhs)
+		{
+			return lhs == nullptr ? rhs : (rhs == nullptr || !Compare{}(*lhs, *rhs) ? lhs : rhs);
+		}
+	};
+
+	template<class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<std::pair<const std::pair<Key, Key>, T>>>
+	class interval_map : public bbst_container<std::pair<Key, Key>, std::pair<const std::pair<Key, Key>, T>, ComPair<std::pair<Key, Key>, T, interval_compare<Key, Compare>>, Allocator,
+	                                           AVL_tree<std::pair<const std::pair<Key, Key>, T>, ComPair<std::pair<Key, Key>, T, interval_compare<Key, Compare>>, Allocator, max_upper_end<Key, T, Compare>>>
+	{
+		public:
+			using base_type      = bbst_container<std::pair<Key, Key>, std::pair<const std::pair<Key, Key>, T>, ComPair<std::pair<Key, Key>, T, interval_compare<Key, Compare>>, Allocator,
+			                                      AVL_tree<std::pair<const std::pair<Key, Key>, T>, ComPair<std::pair<Key, Key>, T, interval_compare<Key, Compare>>, Allocator, max_upper_end<Key, T, Compare>>>;
+			using bound_type     = Key;
+			using key_type       = typename base_type::key_type;
+			using value_type     = typename base_type::value_type;
+			using mapped_type    = T;
+			using iterator       = typename base_type::iterator;
+			using const_iterator = typename base_type::const_iterator;
+
+			using base_type::base_type;
+
+			//finds the first interval (in order) overlapping [lo, hi)
+			const_iterator find_overlap(const bound_type& lo, const bound_type& hi) const
+			{
+				node_pointer found { nullptr };
+
+				overlap(this->bbst.get_root(), lo, hi, [&found](node_pointer ptr) {
+					found = ptr;
+
+					return false;
+				});
+
+				return found == nullptr ? this->cend() : found;
+			}
+
+			//checks if there is an interval overlapping [lo, hi)
+			bool overlaps(const bound_type& lo, const bound_type& hi) const
+			{
+				return find_overlap(lo, hi) != this->cend();
+			}
+
+			//calls func with all intervals (in order) overlapping [lo, hi), in O(min(n, k log n)) for k intervals found
+			template<class Fn>
+			void overlap(const bound_type& lo, const bound_type& hi, Fn func) const
+			{
+				overlap(this->bbst.get_root(), lo, hi, [&func](node_pointer ptr) {
+					func(std::as_const(ptr->value));
+
+					return true;
+				});
+			}
+
+			//calls func with all intervals (in order) containing the point
+			template<class Fn>
+			void stab(const bound_type& point, Fn func) const
+			{
+				overlap(this->bbst.get_root(), point, point, [&func](node_pointer ptr) {
+					func(std::as_const(ptr->value));
+
+					return true;
+				}, true);
+			}
+
+		private:
+			using node_pointer = typename base_type::node_pointer;
+
+			/*
+			 *	inorder traversal of the subtree rooted in the ptr node, skips the subtrees
+			 *		1. with their max upper end not greater than lo (all intervals end before lo)
+			 *		2. on the right of the node with its lower end not less than hi (all intervals start after hi)
+			 *
+			 *	func returns false to stop the traversal
+			 *	closed is true if the upper bound hi is inclusive (for stabbing queries)
+			 */
+			template<class Fn>
+			bool overlap(node_pointer ptr, const bound_type& lo, const bound_type& hi, Fn&& func, bool closed = false) const
+			{
+				Compare cmp {};
+
+				if (ptr == nullptr || !cmp(lo, *ptr->summary))
+					return true;
+
+				if ( !overlap(ptr->left, lo, hi, func, closed) )
+					return false;
+
+				const auto& interval { ptr->value.first };
+
+				if (closed ? cmp(hi, interval.first) : !cmp(interval.first, hi))
+					return true;
+
+				if (cmp(lo, interval.second) && !func(ptr))
+					return false;
+
+				return overlap(ptr->right, lo, hi, func, closed);
+			}
+	};
+}
@@ -3,6 +3,7 @@
 #include <utility>
 #include <stdexcept>
 #include "bbst_container.h"
+#include "btree_container.h"
 
 namespace cust					//customized / non-standard
 {
@@ -27,13 +28,31 @@ namespace cust					//customized / non-standard
 		{
 			return base_type::operator()(key, rhs.first);
 		}
+
+		//heterogeneous comparisons (Compare::is_transparent is inherited as well)
+		template<class K, class C = Compare, class = typename C::is_transparent>
+		constexpr bool operator () (const pair_type& lhs, const K& key) const
+		{
+			return base_type::operator()(lhs.first, key);
+		}
+
+		template<class K, class C = Compare, class = typename C::is_transparent>
+		constexpr bool operator () (const K& key, const pair_type& rhs) const
+		{
+			return base_type::operator()(key, rhs.first);
+		}
 	};
 
-	template<class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<std::pair<const Key, T>>>
-	class map : public bbst_container<Key, std::pair<const Key, T>, ComPair<Key, T, Compare>, Allocator>
+	/*
+	 *	Container: the implementation of the map data container
+	 *	           bbst_container  (AVL tree, by default)
+	 *	           btree_container (B-tree)
+	 */
+	template<class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<std::pair<const Key, T>>, template<class...> class Container = bbst_container>
+	class map : public Container<Key, std::pair<const Key, T>, ComPair<Key, T, Compare>, Allocator>
 	{
 		public:
-			using base_type   = bbst_container<Key, std::pair<const Key, T>, ComPair<Key, T, Compare>, Allocator>;
+			using base_type   = Container<Key, std::pair<const Key, T>, ComPair<Key, T, Compare>, Allocator>;
 			using key_type    = base_type::key_type;
 			using value_type  = base_type::value_type;
 			using mapped_type = T;
@@ -51,22 +70,44 @@ namespace cust					//customized / non-standard
 			//access a specified element with bounds checking
 			mapped_type& at(const key_type& key)
 			{
-				auto ptr { this->bbst.find(key) };
+				auto iter { this->find(key) };
 
-				if (ptr == nullptr)
+				if (iter == this->end())
 					throw std::out_of_range("invalid element access: no such key");
 
-				return ptr->value.second;
+				return iter->second;
 			}
 
 			const mapped_type& at(const key_type& key) const
 			{
-				auto ptr { this->bbst.find(key) };
+				auto iter { this->find(key) };
+
+				if (iter == this->end())
+					throw std::out_of_range("invalid element access: no such key");
+
+				return iter->second;
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			mapped_type& at(const K& key)
+			{
+				auto iter { this->find(key) };
+
+				if (iter == this->end())
+					throw std::out_of_range("invalid element access: no such key");
+
+				return iter->second;
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			const mapped_type& at(const K& key) const
+			{
+				auto iter { this->find(key) };
 
-				if (ptr == nullptr)
+				if (iter == this->end())
 					throw std::out_of_range("invalid element access: no such key");
 
-				return ptr->value.second;
+				return iter->second;
 			}
 
 			//access or insert a specified element
@@ -84,17 +125,40 @@ namespace cust					//customized / non-standard
 			template<class... Args>
 			std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
 			{
-				auto ptr { this->bbst.find(key) };
+				auto iter { this->find(key) };
 
-				return ptr == nullptr ? this->bbst.insert(value_type(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...))) : std::make_pair(ptr, false);
+				return iter == this->end() ? this->insert(value_type(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...))) : std::make_pair(iter, false);
 			}
 
 			template<class... Args>
 			std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
 			{
-				auto ptr { this->bbst.find(key) };
+				auto iter { this->find(key) };
+
+				return iter == this->end() ? this->insert(value_type(std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...))) : std::make_pair(iter, false);
+			}
+	};
+
+	/*
+	 *	multimap data container, the elements with equivalent keys keep the order of insertion
+	 *	(AVL tree with the size of each subtree, count() and equal_range() are O(log n))
+	 */
+	template<class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<std::pair<const Key, T>>>
+	class multimap : public bbst_multicontainer<Key, std::pair<const Key, T>, ComPair<Key, T, Compare>, Allocator, AVL_tree<std::pair<const Key, T>, ComPair<Key, T, Compare>, Allocator, subtree_size>>
+	{
+		public:
+			using base_type   = bbst_multicontainer<Key, std::pair<const Key, T>, ComPair<Key, T, Compare>, Allocator, AVL_tree<std::pair<const Key, T>, ComPair<Key, T, Compare>, Allocator, subtree_size>>;
+			using key_type    = typename base_type::key_type;
+			using value_type  = typename base_type::value_type;
+			using mapped_type = T;
+			using key_compare = Compare;
+
+			using base_type::base_type;
 
-				return ptr == nullptr ? this->bbst.insert(value_type(std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...))) : std::make_pair(ptr, false);
+			//returns the function object that compares the keys
+			key_compare key_comp() const
+			{
+				return key_compare{};
 			}
 	};
 }
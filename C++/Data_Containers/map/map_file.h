@@ -0,0 +1,197 @@
+#pragma once
+
+/*
+ *	binary serialization of map and a read-only map served from a mapped file (trivially copyable keys and mapped values)
+ *
+ *	save() writes the keys and the mapped values in order, load() rebuilds a balanced tree in O(n) (no insertion) with any bbst_container,
+ *	other backends (btree_container) are filled by an insertion at the end of each element,
+ *	mapped_map opens the same file by mmap in O(1) and serves find() / lower_bound() by binary search on the mapped keys
+ */
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include "map.h"
+#include "sorted_file.h"
+
+namespace cust					//customized / non-standard
+{
+	//writes the elements of the map to the binary stream, throws std::runtime_error if the stream fails
+	template<class Key, class T, class Compare, class Allocator, template<class...> class Container>
+	void save(std::ostream& os, const map<Key, T, Compare, Allocator, Container>& mp)
+	{
+		sorted_file_header header {};
+
+		header.key_size    = sizeof(Key);
+		header.mapped_size = sizeof(T);
+		header.count       = mp.size();
+
+		write_header(os, header);
+
+		for (const auto& [key, value] : mp)
+			write_raw(os, key);
+
+		write_padding(os, sorted_file_header::alignment + header.count * sizeof(Key));
+
+		for (const auto& [key, value] : mp)
+			write_raw(os, value);
+
+		if ( !os )
+			throw std::runtime_error("failed to write the map");
+	}
+
+	/*
+	 *	replaces the elements of the map with those read from the binary stream in O(n)
+	 *
+	 *	the keys are checked to be strictly ascending, throws std::runtime_error for an invalid or truncated stream
+	 *	(the map is unchanged for invalid keys, it is left empty for truncated mapped values)
+	 */
+	template<class Key, class T, class Compare, class Allocator, template<class...> class Container>
+	void load(std::istream& is, map<Key, T, Compare, Allocator, Container>& mp)
+	{
+		using value_type = typename map<Key, T, Compare, Allocator, Container>::value_type;
+
+		auto             header { read_header(is, sizeof(Key), sizeof(T)) };
+		std::vector<Key> keys   {};
+		Compare          cmp    {};
+
+		//the count is not trusted for a reservation before the keys are actually read
+		keys.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(header.count, 1 << 20)));
+
+		for (std::uint64_t i { 0 }; i != header.count && is; ++i)
+		{
+			keys.push_back(read_raw<Key>(is));
+
+			if (1 < keys.size() && !cmp(keys[keys.size() - 2], keys.back()))
+				throw std::runtime_error("invalid map file: the keys are not strictly ascending");
+		}
+
+		skip_padding(is, sorted_file_header::alignment + header.count * sizeof(Key));
+
+		if ( !is )
+			throw std::runtime_error("invalid map file: truncated keys");
+
+		std::size_t i { 0 };
+
+		assign_sorted(mp, keys.size(), [&is, &keys, &i]() {
+			auto value { read_raw<T>(is) };
+
+			if ( !is )
+				throw std::runtime_error("invalid map file: truncated mapped values");
+
+			return value_type(keys[i++], value);
+		});
+	}
+
+	/*
+	 *	read-only map served straight from a file written by save(), opened in O(1) by mmap
+	 *
+	 *	the keys and the mapped values are the columns of the file, find() and lower_bound() are binary searches on the keys
+	 *	(the order of the keys is not checked when opening, the file is trusted to be written by save())
+	 */
+	template<class Key, class T, class Compare = std::less<Key>>
+	class mapped_map
+	{
+		static_assert(std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>, "mapped_map needs trivially copyable keys and mapped values");
+
+		public:
+			using key_type    = Key;
+			using mapped_type = T;
+			using size_type   = std::size_t;
+			using key_compare = Compare;
+
+			//opens the file read-only, throws std::runtime_error if the file is not a map file of the types
+			explicit mapped_map(const char* path) : file { path }
+			{
+				sorted_file_header header {};
+
+				if (file.size() < sorted_file_header::alignment)
+					throw std::runtime_error("invalid map file: truncated header");
+
+				std::memcpy(&header, file.data(), sizeof(header));
+
+				header.validate(sizeof(Key), sizeof(T));
+
+				//the count is checked against the size of the file before any offset is computed from it
+				if ( !sorted_file_header::fits(header.count, sizeof(Key), sorted_file_header::alignment, file.size()) )
+					throw std::runtime_error("invalid map file: truncated elements");
+
+				auto offset { sorted_file_header::mapped_offset(header.count, sizeof(Key)) };
+
+				if (header.count != 0 && !sorted_file_header::fits(header.count, sizeof(T), offset, file.size()))
+					throw std::runtime_error("invalid map file: truncated elements");
+
+				count      = static_cast<size_type>(header.count);
+				key_column = reinterpret_cast<const key_type*>(file.data() + sorted_file_header::alignment);
+				val_column = reinterpret_cast<const mapped_type*>(file.data() + offset);
+			}
+
+			//checks if the map is empty
+			bool empty() const noexcept
+			{
+				return count == 0;
+			}
+
+			//gets the number of elements of the map
+			size_type size() const noexcept
+			{
+				return count;
+			}
+
+			//gets the sorted keys
+			const key_type* keys() const noexcept
+			{
+				return key_column;
+			}
+
+			//gets the mapped values in the order of the keys
+			const mapped_type* values() const noexcept
+			{
+				return val_column;
+			}
+
+			//gets the index of the first key not less than key (size() if there is no such key)
+			size_type lower_bound(const key_type& key) const
+			{
+				return static_cast<size_type>(std::lower_bound(key_column, key_column + count, key, cmp) - key_column);
+			}
+
+			//gets the index of the first key greater than key (size() if there is no such key)
+			size_type upper_bound(const key_type& key) const
+			{
+				return static_cast<size_type>(std::upper_bound(key_column, key_column + count, key, cmp) - key_column);
+			}
+
+			//finds the mapped value of the element with the same key, nullptr if there is no such element
+			const mapped_type* find(const key_type& key) const
+			{
+				auto i { lower_bound(key) };
+
+				return i == count || cmp(key, key_column[i]) ? nullptr : val_column + i;
+			}
+
+			//checks if there is an element with the same key
+			bool contains(const key_type& key) const
+			{
+				return find(key) != nullptr;
+			}
+
+			//access a specified element with bounds checking
+			const mapped_type& at(const key_type& key) const
+			{
+				auto ptr { find(key) };
+
+				if (ptr == nullptr)
+					throw std::out_of_range("invalid element access: no such key");
+
+				return *ptr;
+			}
+
+		private:
+			mapped_file        file;
+			const key_type*    key_column { nullptr };
+			const mapped_type* val_column { nullptr };
+			size_type          count      { 0 };
+			key_compare        cmp        {};
+	};
+}
@@ -0,0 +1,608 @@
+#pragma once
+
+/*
+ *	persistent (immutable) AVL tree with path copying
+ *
+ *	an update copies the O(log n) nodes on the path from the root and shares all the other subtrees with the old version,
+ *	the nodes are reference counted (atomically) so that versions can be released by different threads
+ */
+
+#include <cstddef>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <iterator>
+#include <utility>
+#include <initializer_list>
+
+namespace cust					//customized / non-standard
+{
+	template<class T>
+	struct persistent_AVL_tree_node
+	{
+		using value_type      = T;
+		using size_type       = std::size_t;
+		using difference_type = long long;
+		using node_pointer    = persistent_AVL_tree_node*;
+
+		//gets the height of the ptr node
+		static difference_type get_height(const persistent_AVL_tree_node* ptr) noexcept
+		{
+			return ptr == nullptr ? -1 : ptr->height;
+		}
+
+		//adds one more reference to the node (shares the subtree rooted in the node)
+		static node_pointer acquire(node_pointer ptr) noexcept
+		{
+			if (ptr != nullptr)
+				ptr->refs.fetch_add(1, std::memory_order_relaxed);
+
+			return ptr;
+		}
+
+		//removes one reference to the node, deletes the node (and releases its children) if it is the last one
+		template<class Allocator>
+		static void release(Allocator& alloc, node_pointer ptr) noexcept
+		{
+			for ( ; ptr != nullptr && ptr->refs.fetch_sub(1, std::memory_order_acq_rel) == 1; )
+			{
+				auto right { ptr->right };
+
+				release(alloc, ptr->left);
+
+				std::allocator_traits<Allocator>::destroy(alloc, ptr);
+				std::allocator_traits<Allocator>::deallocate(alloc, ptr, 1);
+
+				ptr = right;			//releases the right child in the loop (tail call)
+			}
+		}
+
+		//adds a tree node with the children l and r (takes over their references, they are released if it throws)
+		template<class Allocator, class... Args>
+		[[nodiscard]] static node_pointer new_node(Allocator& alloc, node_pointer l, node_pointer r, Args&&... args)
+		{
+			node_pointer ptr { nullptr };
+
+			try
+			{
+				ptr = std::allocator_traits<Allocator>::allocate(alloc, 1);
+
+				std::allocator_traits<Allocator>::construct(alloc, ptr, l, r, std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				if (ptr != nullptr)
+					std::allocator_traits<Allocator>::deallocate(alloc, ptr, 1);
+
+				release(alloc, l);
+				release(alloc, r);
+
+				throw;
+			}
+
+			return ptr;
+		}
+
+		template<class... Args>
+		persistent_AVL_tree_node(node_pointer l, node_pointer r, Args&&... args) : left { l }, right { r }, height { std::max(get_height(l), get_height(r)) + 1 }, value(std::forward<Args>(args)...)
+		{
+		}
+
+		const node_pointer        left   { nullptr };		//pointer pointing to left  child node
+		const node_pointer        right  { nullptr };		//pointer pointing to right child node
+		std::atomic<size_type>    refs   { 1 };			//the number of references (parent nodes and versions) to the node
+		const difference_type     height { 0 };			//height of the node
+		const value_type          value  {};
+	};
+
+	//forward iterator of persistent AVL tree, keeps the path of pending ancestors in a fixed-size stack (no parent pointers)
+	template<class T>
+	class persistent_AVL_tree_iterator
+	{
+		//friend class forward declaration
+		template<class, class, class>
+		friend class persistent_AVL_tree;
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type        = T;
+			using difference_type   = std::ptrdiff_t;
+			using pointer           = const value_type*;
+			using reference         = const value_type&;
+			using node_pointer      = typename persistent_AVL_tree_node<T>::node_pointer;
+
+			//the height of an AVL tree is less than 1.45 * log2(n + 2), 64 levels are far beyond any tree that fits in memory
+			static constexpr std::size_t max_height { 64 };
+
+			reference operator * () const noexcept
+			{
+				return stack[top - 1]->value;
+			}
+
+			pointer operator -> () const noexcept
+			{
+				return std::addressof(stack[top - 1]->value);
+			}
+
+			auto& operator ++ () noexcept
+			{
+				auto ptr { stack[--top] };
+
+				push_left(ptr->right);
+
+				return *this;
+			}
+
+			auto operator ++ (int) noexcept
+			{
+				auto tmp { *this };
+
+				operator++();
+
+				return tmp;
+			}
+
+			bool operator == (const persistent_AVL_tree_iterator& other) const noexcept
+			{
+				return get_node() == other.get_node();
+			}
+
+			bool operator != (const persistent_AVL_tree_iterator& other) const noexcept
+			{
+				return !(*this == other);
+			}
+
+		private:
+			//pushes the node and all of its left descendants
+			void push_left(node_pointer ptr) noexcept
+			{
+				for ( ; ptr != nullptr; ptr = ptr->left)
+					stack[top++] = ptr;
+			}
+
+			//gets the node the iterator points to (nullptr for the end iterator)
+			node_pointer get_node() const noexcept
+			{
+				return top == 0 ? nullptr : stack[top - 1];
+			}
+
+			node_pointer stack[max_height] {};		//the current node (on the top) and the ancestors to visit after it
+			std::size_t  top { 0 };
+	};
+
+	/*
+	 *	a version of a persistent AVL tree
+	 *
+	 *	copying a version is O(1) (it shares the root), an update returns a new version and leaves this one unchanged,
+	 *	all nodes are immutable so different threads can read (and release) versions sharing nodes without locking
+	 *
+	 *	the allocators of the versions sharing nodes must compare equal (e.g. std::allocator)
+	 */
+	template<class T, class Compare = std::less<T>, class Allocator = std::allocator<T>>
+	class persistent_AVL_tree
+	{
+		public:
+			using value_type      = T;
+			using size_type       = std::size_t;
+			using difference_type = std::ptrdiff_t;
+			using const_pointer   = const value_type*;
+			using const_reference = const value_type&;
+			using node_type       = persistent_AVL_tree_node<value_type>;
+			using node_pointer    = node_type*;
+			using allocator_type  = typename std::allocator_traits<Allocator>::template rebind_alloc<node_type>;
+			using const_iterator  = persistent_AVL_tree_iterator<value_type>;
+
+			//default constructor
+			persistent_AVL_tree() = default;
+
+			//copy constructor, shares all nodes
+			persistent_AVL_tree(const persistent_AVL_tree& other) : impl { other.impl }
+			{
+				node_type::acquire(impl.root);
+			}
+
+			//move constructor
+			persistent_AVL_tree(persistent_AVL_tree&& other) noexcept : impl { other.impl }
+			{
+				other.impl.root = nullptr;
+				other.impl.sz   = 0;
+			}
+
+			//constructor with initializer list
+			persistent_AVL_tree(std::initializer_list<value_type> init)
+			{
+				for (const auto& elem : init)
+					*this = insert(elem);
+			}
+
+			//destructor
+			~persistent_AVL_tree()
+			{
+				node_type::release(node_allocator(), impl.root);
+			}
+
+			//copy assignment
+			persistent_AVL_tree& operator = (const persistent_AVL_tree& other)
+			{
+				if (this != &other)
+				{
+					node_type::acquire(other.impl.root);
+					node_type::release(node_allocator(), impl.root);
+
+					impl = other.impl;
+				}
+
+				return *this;
+			}
+
+			//move assignment
+			persistent_AVL_tree& operator = (persistent_AVL_tree&& other) noexcept
+			{
+				swap(other);
+
+				return *this;
+			}
+
+			//checks if the tree is empty
+			bool empty() const noexcept
+			{
+				return impl.sz == 0;
+			}
+
+			//gets the number of elements of the tree
+			size_type size() const noexcept
+			{
+				return impl.sz;
+			}
+
+			//gets the height of the tree
+			difference_type height() const noexcept
+			{
+				return node_type::get_height(impl.root);
+			}
+
+			//exchanges the elements of the tree with those of other
+			void swap(persistent_AVL_tree& other) noexcept
+			{
+				std::swap(impl.root, other.impl.root);
+				std::swap(impl.sz,   other.impl.sz);
+			}
+
+			//returns a new version with the value inserted (the same version if the key or value exists)
+			persistent_AVL_tree insert(const value_type& value) const
+			{
+				return update(value, false);
+			}
+
+			//returns a new version with the value inserted or assigned to the element with the equivalent key or value
+			persistent_AVL_tree insert_or_assign(const value_type& value) const
+			{
+				return update(value, true);
+			}
+
+			//returns a new version without the element with the equivalent val (the same version if there is no such element)
+			template<class Ty>
+			persistent_AVL_tree erase(const Ty& val) const
+			{
+				bool found { false };
+				auto root  { erase(impl.root, val, found) };
+
+				if ( !found )
+					return *this;
+
+				return persistent_AVL_tree(get_allocator(), get_compare(), root, impl.sz - 1);
+			}
+
+			//finds the element with the equivalent val of the tree
+			template<class Ty>
+			const_pointer find(const Ty& val) const
+			{
+				auto& cmp { get_compare() };
+
+				for (auto ptr { impl.root }; ptr != nullptr; )
+				{
+					if (cmp(ptr->value, val))
+						ptr = ptr->right;
+					else if (cmp(val, ptr->value))
+						ptr = ptr->left;
+					else
+						return std::addressof(ptr->value);
+				}
+
+				return nullptr;
+			}
+
+			//checks if there is an element with the equivalent val of the tree
+			template<class Ty>
+			bool contains(const Ty& val) const
+			{
+				return find(val) != nullptr;
+			}
+
+			//finds the first element with the key or value that is not less than val
+			template<class Ty>
+			const_iterator lower_bound(const Ty& val) const
+			{
+				const_iterator iter {};
+				auto&          cmp  { get_compare() };
+
+				for (auto ptr { impl.root }; ptr != nullptr; )
+				{
+					if (cmp(ptr->value, val))
+						ptr = ptr->right;
+					else
+					{
+						iter.stack[iter.top++] = ptr;
+						ptr = ptr->left;
+					}
+				}
+
+				return iter;
+			}
+
+			//finds the first element with the key or value that is greater than val
+			template<class Ty>
+			const_iterator upper_bound(const Ty& val) const
+			{
+				const_iterator iter {};
+				auto&          cmp  { get_compare() };
+
+				for (auto ptr { impl.root }; ptr != nullptr; )
+				{
+					if (cmp(val, ptr->value))
+					{
+						iter.stack[iter.top++] = ptr;
+						ptr = ptr->left;
+					}
+					else
+						ptr = ptr->right;
+				}
+
+				return iter;
+			}
+
+			//returns an iterator to the beginning (valid as long as the version is alive)
+			const_iterator begin() const noexcept
+			{
+				const_iterator iter {};
+
+				iter.push_left(impl.root);
+
+				return iter;
+			}
+
+			//returns an iterator to the end
+			const_iterator end() const noexcept
+			{
+				return const_iterator {};
+			}
+
+			//performs an inorder traversal
+			template<class Fn>
+			void inorder(Fn func) const
+			{
+				inorder(impl.root, func);
+			}
+
+			//gets the root node (for the containers built on the tree)
+			node_pointer get_root() const noexcept
+			{
+				return impl.root;
+			}
+
+			//returns the allocator associated with the tree
+			allocator_type get_allocator() const noexcept
+			{
+				return impl;
+			}
+
+			//returns the compare function object
+			const Compare& get_compare() const noexcept
+			{
+				return impl;
+			}
+
+		private:
+			//constructor of a new version, takes over the reference to the root node
+			persistent_AVL_tree(const allocator_type& alloc, const Compare& cmp, node_pointer root, size_type sz) : impl { cmp, alloc }
+			{
+				impl.root = root;
+				impl.sz   = sz;
+			}
+
+			//returns a new version with the value inserted (or assigned)
+			persistent_AVL_tree update(const value_type& value, bool assign) const
+			{
+				bool found { false };
+				auto root  { insert(impl.root, value, assign, found) };
+
+				if (root == nullptr)
+					return *this;
+
+				return persistent_AVL_tree(get_allocator(), get_compare(), root, found ? impl.sz : impl.sz + 1);
+			}
+
+			/*
+			 *	creates a balanced node from the left subtree, the value and the right subtree (heights differ by at most 2)
+			 *	single or double rotation is done by creating the new nodes directly, the shared nodes are never modified
+			 *
+			 *	takes over the references to l and r (they are released if it throws),
+			 *	a reference is handed to new_node() by std::exchange, so what is still owned here is released on a throw
+			 */
+			node_pointer balance(node_pointer l, const value_type& value, node_pointer r) const
+			{
+				auto         alloc { get_allocator() };
+				auto         hl    { node_type::get_height(l) };
+				auto         hr    { node_type::get_height(r) };
+				node_pointer ptr   { nullptr };
+				node_pointer inner { nullptr };		//the first new node of a rotation until the root of the rotation takes it over
+
+				try
+				{
+					if (hr + 1 < hl)
+					{
+						if (node_type::get_height(l->right) <= node_type::get_height(l->left))		//left-left case: right rotation
+						{
+							inner = node_type::new_node(alloc, node_type::acquire(l->right), std::exchange(r, nullptr), value);
+							ptr   = node_type::new_node(alloc, node_type::acquire(l->left), std::exchange(inner, nullptr), l->value);
+						}
+						else									//left-right case: double rotation
+						{
+							auto lr { l->right };
+
+							inner = node_type::new_node(alloc, node_type::acquire(l->left), node_type::acquire(lr->left), l->value);
+
+							auto right { node_type::new_node(alloc, node_type::acquire(lr->right), std::exchange(r, nullptr), value) };
+
+							ptr = node_type::new_node(alloc, std::exchange(inner, nullptr), right, lr->value);
+						}
+
+						node_type::release(alloc, std::exchange(l, nullptr));
+					}
+					else if (hl + 1 < hr)
+					{
+						if (node_type::get_height(r->left) <= node_type::get_height(r->right))		//right-right case: left rotation
+						{
+							inner = node_type::new_node(alloc, std::exchange(l, nullptr), node_type::acquire(r->left), value);
+							ptr   = node_type::new_node(alloc, std::exchange(inner, nullptr), node_type::acquire(r->right), r->value);
+						}
+						else									//right-left case: double rotation
+						{
+							auto rl { r->left };
+
+							inner = node_type::new_node(alloc, std::exchange(l, nullptr), node_type::acquire(rl->left), value);
+
+							auto right { node_type::new_node(alloc, node_type::acquire(rl->right), node_type::acquire(r->right), r->value) };
+
+							ptr = node_type::new_node(alloc, std::exchange(inner, nullptr), right, rl->value);
+						}
+
+						node_type::release(alloc, std::exchange(r, nullptr));
+					}
+					else
+						ptr = node_type::new_node(alloc, std::exchange(l, nullptr), std::exchange(r, nullptr), value);
+				}
+				catch (...)
+				{
+					node_type::release(alloc, l);
+					node_type::release(alloc, r);
+					node_type::release(alloc, inner);
+
+					throw;
+				}
+
+				return ptr;
+			}
+
+			/*
+			 *	inserts the value into the subtree rooted in the ptr node by path copying
+			 *
+			 *	return value: the root of the new subtree, or nullptr if nothing changes (the value exists and assign is false)
+			 */
+			node_pointer insert(node_pointer ptr, const value_type& value, bool assign, bool& found) const
+			{
+				auto  alloc { get_allocator() };
+				auto& cmp   { get_compare() };
+
+				if (ptr == nullptr)
+					return node_type::new_node(alloc, nullptr, nullptr, value);
+
+				if (cmp(value, ptr->value))
+				{
+					auto left { insert(ptr->left, value, assign, found) };
+
+					return left == nullptr ? nullptr : balance(left, ptr->value, node_type::acquire(ptr->right));
+				}
+
+				if (cmp(ptr->value, value))
+				{
+					auto right { insert(ptr->right, value, assign, found) };
+
+					return right == nullptr ? nullptr : balance(node_type::acquire(ptr->left), ptr->value, right);
+				}
+
+				found = true;
+
+				return assign ? node_type::new_node(alloc, node_type::acquire(ptr->left), node_type::acquire(ptr->right), value) : nullptr;
+			}
+
+			//erases the element with the equivalent val from the subtree rooted in the ptr node by path copying
+			template<class Ty>
+			node_pointer erase(node_pointer ptr, const Ty& val, bool& found) const
+			{
+				auto& cmp { get_compare() };
+
+				if (ptr == nullptr)
+					return nullptr;
+
+				if (cmp(val, ptr->value))
+				{
+					auto left { erase(ptr->left, val, found) };
+
+					return found ? balance(left, ptr->value, node_type::acquire(ptr->right)) : nullptr;
+				}
+
+				if (cmp(ptr->value, val))
+				{
+					auto right { erase(ptr->right, val, found) };
+
+					return found ? balance(node_type::acquire(ptr->left), ptr->value, right) : nullptr;
+				}
+
+				found = true;
+
+				if (ptr->left == nullptr)
+					return node_type::acquire(ptr->right);
+
+				if (ptr->right == nullptr)
+					return node_type::acquire(ptr->left);
+
+				//replaces the value with its successor (the min value of the right subtree)
+				const_pointer succ  { nullptr };
+				auto          right { erase_min(ptr->right, succ) };
+
+				return balance(node_type::acquire(ptr->left), *succ, right);
+			}
+
+			//erases the min element from the subtree rooted in the ptr node, min points to the erased value (kept alive by the old version)
+			node_pointer erase_min(node_pointer ptr, const_pointer& min) const
+			{
+				if (ptr->left == nullptr)
+				{
+					min = std::addressof(ptr->value);
+
+					return node_type::acquire(ptr->right);
+				}
+
+				auto left { erase_min(ptr->left, min) };
+
+				return balance(left, ptr->value, node_type::acquire(ptr->right));
+			}
+
+			template<class Fn>
+			static void inorder(node_pointer ptr, Fn& func)
+			{
+				if (ptr != nullptr)
+				{
+					inorder(ptr->left, func);
+					func(ptr->value);
+					inorder(ptr->right, func);
+				}
+			}
+
+			//gets the node allocator
+			allocator_type& node_allocator() noexcept
+			{
+				return impl;
+			}
+
+			//implementation type
+			struct impl_type : public Compare, allocator_type
+			{
+				node_pointer root { nullptr };			//a pointer pointing to the root node
+				size_type    sz   { 0 };			//the number of elements of the tree
+			};
+
+			impl_type impl {};					//implementation of persistent AVL tree
+	};
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+/*
+ *	persistent (immutable) map data container
+ *
+ *	a version of the map is never modified, an update returns a new version in O(log n) by copying the path from the root
+ *	and sharing all other subtrees (reference counted), copying a version is O(1),
+ *	old versions stay valid and readable by any thread without locking as long as they are held
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include "map.h"
+#include "persistent_AVL_tree.h"
+
+namespace cust					//customized / non-standard
+{
+	template<class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<std::pair<const Key, T>>>
+	class persistent_map
+	{
+		public:
+			using key_type       = Key;
+			using mapped_type    = T;
+			using value_type     = std::pair<const Key, T>;
+			using size_type      = std::size_t;
+			using key_compare    = Compare;
+			using allocator_type = Allocator;
+			using tree_type      = persistent_AVL_tree<value_type, ComPair<Key, T, Compare>, Allocator>;
+			using const_iterator = typename tree_type::const_iterator;
+			using iterator       = const_iterator;
+
+			//default constructor
+			persistent_map() = default;
+
+			//range constructor
+			template<class InputIter>
+			persistent_map(InputIter first, InputIter last)
+			{
+				for ( ; first != last; ++first)
+					tree = tree.insert(*first);
+			}
+
+			//constructor with initializer list
+			persistent_map(std::initializer_list<value_type> init) : tree { init }
+			{
+			}
+
+			//checks if the map is empty
+			bool empty() const noexcept
+			{
+				return tree.empty();
+			}
+
+			//gets the number of elements of the map
+			size_type size() const noexcept
+			{
+				return tree.size();
+			}
+
+			//returns the function object that compares the keys
+			key_compare key_comp() const
+			{
+				return key_compare{};
+			}
+
+			//exchanges the versions held by two maps
+			void swap(persistent_map& other) noexcept
+			{
+				tree.swap(other.tree);
+			}
+
+			//returns a new version with the element inserted (the same version if the key exists)
+			[[nodiscard]] persistent_map insert(const value_type& value) const
+			{
+				return persistent_map(tree.insert(value));
+			}
+
+			//returns a new version with the element inserted or its mapped value assigned
+			template<class M>
+			[[nodiscard]] persistent_map insert_or_assign(const key_type& key, M&& obj) const
+			{
+				return persistent_map(tree.insert_or_assign(value_type(key, std::forward<M>(obj))));
+			}
+
+			//returns a new version without the element with the same key (the same version if there is no such element)
+			[[nodiscard]] persistent_map erase(const key_type& key) const
+			{
+				return persistent_map(tree.erase(key));
+			}
+
+			//finds the element with the same key
+			const_iterator find(const key_type& key) const
+			{
+				auto iter { tree.lower_bound(key) };
+
+				return iter == end() || key_comp()(key, iter->first) ? end() : iter;
+			}
+
+			//checks if there is an element with the same key
+			bool contains(const key_type& key) const
+			{
+				return tree.contains(key);
+			}
+
+			//returns the number of elements with the same key
+			size_type count(const key_type& key) const
+			{
+				return contains(key) ? 1 : 0;
+			}
+
+			//access a specified element with bounds checking
+			const mapped_type& at(const key_type& key) const
+			{
+				auto ptr { tree.find(key) };
+
+				if (ptr == nullptr)
+					throw std::out_of_range("invalid element access: no such key");
+
+				return ptr->second;
+			}
+
+			//finds the first element with the key not less than key
+			const_iterator lower_bound(const key_type& key) const
+			{
+				return tree.lower_bound(key);
+			}
+
+			//finds the first element with the key greater than key
+			const_iterator upper_bound(const key_type& key) const
+			{
+				return tree.upper_bound(key);
+			}
+
+			//returns an iterator to the beginning (valid as long as the version is alive)
+			const_iterator begin() const noexcept
+			{
+				return tree.begin();
+			}
+
+			//returns an iterator to the end
+			const_iterator end() const noexcept
+			{
+				return tree.end();
+			}
+
+			//checks if two versions share the same root (the same version or a version without changes)
+			bool same_version(const persistent_map& other) const noexcept
+			{
+				return tree.get_root() == other.tree.get_root();
+			}
+
+		private:
+			//constructor with a version of the tree
+			explicit persistent_map(tree_type&& version) noexcept : tree { std::move(version) }
+			{
+			}
+
+			tree_type tree {};
+	};
+
+	template<class Key, class T, class Compare, class Allocator>
+	bool operator == (const persistent_map<Key, T, Compare, Allocator>& lhs, const persistent_map<Key, T, Compare, Allocator>& rhs)
+	{
+		return lhs.same_version(rhs) || (lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template<class Key, class T, class Compare, class Allocator>
+	bool operator != (const persistent_map<Key, T, Compare, Allocator>& lhs, const persistent_map<Key, T, Compare, Allocator>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+}
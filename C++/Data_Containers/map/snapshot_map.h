@@ -0,0 +1,330 @@
+#pragma once
+
+/*
+ *	snapshot map data container, for many concurrent readers and rare writers (read-copy-update)
+ *
+ *	the map is a persistent AVL tree, a writer builds a new version by path copying (sharing all unchanged subtrees)
+ *	and publishes it by storing the atomic root pointer, a reader loads the root pointer and reads a consistent version
+ *	that is never modified
+ *
+ *	the retired versions are reclaimed by epochs: a reader pins the current epoch in a record of its own thread
+ *	(a store and a fence, no read-modify-write on shared data, so the reads are wait-free and do not contend),
+ *	a writer tags the version it replaces with the epoch and frees it once every pinned reader is at a later epoch
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "map.h"
+#include "persistent_AVL_tree.h"
+
+namespace cust					//customized / non-standard
+{
+	/*
+	 *	epoch based reclamation shared by all snapshot maps
+	 *
+	 *	each thread gets a record on its first pin (a record of an exited thread is reused), the records are never unlinked,
+	 *	a pin stores the current epoch in the record of the thread, an unpin stores idle
+	 */
+	class epoch_domain
+	{
+		public:
+			static constexpr std::uint64_t idle { std::numeric_limits<std::uint64_t>::max() };
+
+			//the epoch pinned by a thread, on its own cache line
+			struct alignas(64) record
+			{
+				std::atomic<std::uint64_t> epoch { idle };
+				std::atomic<bool>          used  { true };
+				std::size_t                depth { 0 };		//the number of nested pins (only touched by its thread)
+				record*                    next  { nullptr };
+			};
+
+			//pins the calling thread to the current epoch while it is alive (pins nest)
+			class pin
+			{
+				public:
+					explicit pin(epoch_domain& domain) : rec { domain.local() }
+					{
+						if (rec.depth++ == 0)
+						{
+							rec.epoch.store(domain.epoch.load(std::memory_order_seq_cst), std::memory_order_relaxed);
+							std::atomic_thread_fence(std::memory_order_seq_cst);
+						}
+					}
+
+					pin(const pin&) = delete;
+					pin& operator = (const pin&) = delete;
+
+					~pin()
+					{
+						if (--rec.depth == 0)
+							rec.epoch.store(idle, std::memory_order_release);
+					}
+
+				private:
+					record& rec;
+			};
+
+			//gets the domain
+			static epoch_domain& instance()
+			{
+				static epoch_domain domain {};
+
+				return domain;
+			}
+
+			epoch_domain(const epoch_domain&) = delete;
+			epoch_domain& operator = (const epoch_domain&) = delete;
+
+			//destructor (after all threads have exited)
+			~epoch_domain()
+			{
+				for (auto ptr { head.load(std::memory_order_acquire) }; ptr != nullptr; )
+					delete std::exchange(ptr, ptr->next);
+			}
+
+			//starts a new epoch, returns the previous one (an object retired now is tagged with it)
+			std::uint64_t advance() noexcept
+			{
+				return epoch.fetch_add(1, std::memory_order_seq_cst);
+			}
+
+			//gets the min epoch pinned by a thread, idle if no thread is pinned (an object tagged before it can be freed)
+			std::uint64_t min_pinned() const noexcept
+			{
+				auto min { idle };
+
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
+				for (auto ptr { head.load(std::memory_order_acquire) }; ptr != nullptr; ptr = ptr->next)
+					min = std::min(min, ptr->epoch.load(std::memory_order_seq_cst));
+
+				return min;
+			}
+
+		private:
+			epoch_domain() = default;
+
+			//releases the record of the thread when it exits
+			struct local_record
+			{
+				~local_record()
+				{
+					rec->used.store(false, std::memory_order_release);
+				}
+
+				record* rec { nullptr };
+			};
+
+			//gets the record of the calling thread
+			record& local()
+			{
+				thread_local local_record holder { acquire_record() };
+
+				return *holder.rec;
+			}
+
+			//reuses the record of an exited thread or links a new one at the head
+			record* acquire_record()
+			{
+				for (auto ptr { head.load(std::memory_order_acquire) }; ptr != nullptr; ptr = ptr->next)
+				{
+					auto used { false };
+
+					if ( !ptr->used.load(std::memory_order_relaxed) && ptr->used.compare_exchange_strong(used, true, std::memory_order_acquire) )
+						return ptr;
+				}
+
+				auto ptr { new record {} };
+
+				ptr->next = head.load(std::memory_order_relaxed);
+
+				while ( !head.compare_exchange_weak(ptr->next, ptr, std::memory_order_release, std::memory_order_relaxed) )
+					;
+
+				return ptr;
+			}
+
+			std::atomic<std::uint64_t> epoch { 0 };
+			std::atomic<record*>       head  { nullptr };
+	};
+
+	template<class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<std::pair<const Key, T>>>
+	class snapshot_map
+	{
+		public:
+			using key_type       = Key;
+			using mapped_type    = T;
+			using value_type     = std::pair<const Key, T>;
+			using size_type      = std::size_t;
+			using key_compare    = Compare;
+			using allocator_type = Allocator;
+			using tree_type      = persistent_AVL_tree<value_type, ComPair<Key, T, Compare>, Allocator>;
+			using snapshot_type  = tree_type;
+
+			static_assert(std::atomic<const tree_type*>::is_always_lock_free && std::atomic<std::uint64_t>::is_always_lock_free,
+			              "the readers of snapshot_map need lock-free atomic pointers and epochs");
+
+			//default constructor
+			snapshot_map() : root { new tree_type {} }
+			{
+			}
+
+			//constructor with initializer list
+			snapshot_map(std::initializer_list<value_type> init) : root { new tree_type(init) }
+			{
+			}
+
+			//a snapshot map is shared by threads, it is neither copyable nor movable (copy a snapshot instead)
+			snapshot_map(const snapshot_map&) = delete;
+			snapshot_map& operator = (const snapshot_map&) = delete;
+
+			//destructor (no reader or writer may be running)
+			~snapshot_map()
+			{
+				delete root.load(std::memory_order_relaxed);
+
+				for (const auto& [ptr, epoch] : retired)
+					delete ptr;
+			}
+
+			/*
+			 *	runs func on the current version (const tree_type&) and returns its result, wait-free
+			 *
+			 *	the version stays valid during the call, no pointer or reference into it may escape func
+			 */
+			template<class Fn>
+			decltype(auto) read(Fn func) const
+			{
+				epoch_domain::pin pin { epoch_domain::instance() };
+
+				return func(*root.load(std::memory_order_seq_cst));
+			}
+
+			/*
+			 *	gets a consistent snapshot (a copy of the current version) of the map for reading
+			 *
+			 *	a snapshot stays unchanged and valid as long as it is held by any thread, whatever the writers do,
+			 *	it takes a reference to the shared root node (an atomic increment), so prefer read() for short reads
+			 */
+			snapshot_type snapshot() const
+			{
+				return read([](const tree_type& tree) { return tree; });
+			}
+
+			//checks if the map is empty
+			bool empty() const
+			{
+				return read([](const tree_type& tree) { return tree.empty(); });
+			}
+
+			//gets the number of elements of the map
+			size_type size() const
+			{
+				return read([](const tree_type& tree) { return tree.size(); });
+			}
+
+			//checks if there is an element with the same key
+			bool contains(const key_type& key) const
+			{
+				return read([&key](const tree_type& tree) { return tree.contains(key); });
+			}
+
+			//gets a copy of the mapped value of the element with the same key (no reference escapes the version)
+			std::optional<mapped_type> get(const key_type& key) const
+			{
+				return read([&key](const tree_type& tree) {
+					auto ptr { tree.find(key) };
+
+					return ptr == nullptr ? std::nullopt : std::optional<mapped_type>(ptr->second);
+				});
+			}
+
+			//inserts an element if the key does not exist, returns true if inserted
+			bool insert(const value_type& value)
+			{
+				return publish([&value](const tree_type& tree) { return tree.insert(value); }) == 1;
+			}
+
+			//inserts an element or assigns to the mapped value of the existing element, returns true if inserted
+			template<class M>
+			bool insert_or_assign(const key_type& key, M&& obj)
+			{
+				value_type value(key, std::forward<M>(obj));
+
+				return publish([&value](const tree_type& tree) { return tree.insert_or_assign(value); }) == 1;
+			}
+
+			//removes the element with the same key, returns the number of elements removed
+			size_type erase(const key_type& key)
+			{
+				return publish([&key](const tree_type& tree) { return tree.erase(key); }) == -1 ? 1 : 0;
+			}
+
+			//clears all elements of the map
+			void clear()
+			{
+				publish([](const tree_type&) { return tree_type {}; });
+			}
+
+			/*
+			 *	applies a batch of updates and publishes them at once, readers see all of them or none of them
+			 *
+			 *	func takes the current version (const tree_type&) and returns the new version (tree_type)
+			 */
+			template<class Fn>
+			void update(Fn func)
+			{
+				publish(func);
+			}
+
+		private:
+			/*
+			 *	builds the new version from the current one and publishes it (writers are serialized, readers never wait),
+			 *	then frees the retired versions no pinned reader can still be reading
+			 */
+			template<class Fn>
+			long long publish(Fn&& func)
+			{
+				std::lock_guard<std::mutex> lock { mtx };
+
+				auto& domain { epoch_domain::instance() };
+				auto  curr   { root.load(std::memory_order_relaxed) };
+				auto  next   { std::make_unique<const tree_type>(func(*curr)) };
+
+				//nothing changes
+				if (next->get_root() == curr->get_root())
+					return 0;
+
+				auto diff { static_cast<long long>(next->size()) - static_cast<long long>(curr->size()) };
+
+				retired.reserve(retired.size() + 1);
+				root.store(next.release(), std::memory_order_seq_cst);
+				retired.emplace_back(curr, domain.advance());
+
+				auto min { domain.min_pinned() };
+
+				std::erase_if(retired, [min](const auto& pr) {
+					if (min <= pr.second)
+						return false;
+
+					delete pr.first;
+
+					return true;
+				});
+
+				return diff;
+			}
+
+			std::atomic<const tree_type*>                        root;			//the current version
+			std::vector<std::pair<const tree_type*, std::uint64_t>> retired {};		//the replaced versions and their epochs
+			std::mutex                                           mtx;			//serializes the writers
+	};
+}
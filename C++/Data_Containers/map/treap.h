@@ -0,0 +1,902 @@
+#pragma once
+
+/*
+ *	treap, a binary search tree whose nodes are also a max-heap of random priorities
+ *
+ *	the shape of the tree is that of inserting the elements in random order, so the expected height is O(log n)
+ *	whatever the order of insertion, a new node is rotated up and a removed node is rotated down, about 2 rotations on average,
+ *	lookups do not modify the tree
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <initializer_list>
+#include <iterator>
+#include <queue>
+#include <vector>
+
+namespace cust					//customized / non-standard
+{
+	template<class T>
+	struct treap_node
+	{
+		using value_type   = T;
+		using node_pointer = treap_node*;
+
+		//adds a tree node by allocating memory space and calling its constructor
+		template<class Allocator, class... Args>
+		[[nodiscard]] static node_pointer new_node(Allocator& alloc, Args&&... args)
+		{
+			auto ptr { std::allocator_traits<Allocator>::allocate(alloc, 1) };
+
+			ptr->parent = ptr->right = ptr->left = nullptr;
+			std::allocator_traits<Allocator>::construct(alloc, std::addressof(ptr->value), std::forward<Args>(args)...);
+
+			return ptr;
+		}
+
+		//deletes a tree node by calling its destructor and deallocating memory space
+		template<class Allocator>
+		static void delete_one_node(Allocator& alloc, node_pointer ptr) noexcept
+		{
+			std::allocator_traits<Allocator>::destroy(alloc, ptr);
+			std::allocator_traits<Allocator>::deallocate(alloc, ptr, 1);
+		}
+
+		//copies the subtree rooted in the src node (side by side without recursion, the parent pointers lead the way back up)
+		template<class Allocator>
+		[[nodiscard]] static node_pointer copy_nodes(Allocator& alloc, node_pointer src)
+		{
+			if (src == nullptr)
+				return nullptr;
+
+			auto root { new_node(alloc, src->value) };
+
+			root->priority = src->priority;
+
+			for (auto ptr { root }; ; )
+			{
+				if (src->left != nullptr && ptr->left == nullptr)
+				{
+					src = src->left;
+					ptr->left = new_node(alloc, src->value);
+					ptr->left->parent   = ptr;
+					ptr->left->priority = src->priority;
+					ptr = ptr->left;
+				}
+				else if (src->right != nullptr && ptr->right == nullptr)
+				{
+					src = src->right;
+					ptr->right = new_node(alloc, src->value);
+					ptr->right->parent   = ptr;
+					ptr->right->priority = src->priority;
+					ptr = ptr->right;
+				}
+				else
+				{
+					if (ptr == root)
+						break;
+
+					src = src->parent;
+					ptr = ptr->parent;
+				}
+			}
+
+			return root;
+		}
+
+		//finds the node with the max value of the subtree rooted in the parent node
+		static node_pointer max(node_pointer ptr) noexcept
+		{
+			for ( ; ptr != nullptr && ptr->right != nullptr; ptr = ptr->right);
+
+			return ptr;
+		}
+
+		//finds the node with the min value of the subtree rooted in the parent node
+		static node_pointer min(node_pointer ptr) noexcept
+		{
+			for ( ; ptr != nullptr && ptr->left != nullptr; ptr = ptr->left);
+
+			return ptr;
+		}
+
+		//finds the successor of the node pointed by ptr
+		static node_pointer successor(node_pointer ptr) noexcept
+		{
+			if (ptr != nullptr)
+			{
+				if (ptr->right != nullptr)
+					return min(ptr->right);
+
+				auto parent { ptr->parent };
+
+				for ( ; parent != nullptr && parent->right == ptr; )
+				{
+					ptr    = parent;
+					parent = parent->parent;
+				}
+
+				ptr = parent;
+			}
+
+			return ptr;
+		}
+
+		//finds the predecessor of the node pointed by ptr
+		static node_pointer predecessor(node_pointer ptr) noexcept
+		{
+			if (ptr != nullptr)
+			{
+				if (ptr->left != nullptr)
+					return max(ptr->left);
+
+				auto parent { ptr->parent };
+
+				for ( ; parent != nullptr && parent->left == ptr; )
+				{
+					ptr    = parent;
+					parent = parent->parent;
+				}
+
+				ptr = parent;
+			}
+
+			return ptr;
+		}
+
+		node_pointer  left     { nullptr };			//pointer pointing to left  child node
+		node_pointer  right    { nullptr };			//pointer pointing to right child node
+		node_pointer  parent   { nullptr };			//pointer pointing to parent      node
+		std::uint32_t priority { 0 };				//random priority, not less than those of the children (max-heap)
+		value_type    value    {};
+	};
+
+	template<class T, class Compare = std::less<T>, class Allocator = std::allocator<T>>
+	class treap
+	{
+		public:
+			using value_type         = T;
+			using size_type          = std::size_t;
+			using difference_type    = std::ptrdiff_t;
+			using pointer            = value_type*;
+			using const_pointer      = const value_type*;
+			using reference          = value_type&;
+			using const_reference    = const value_type&;
+			using node_type          = treap_node<value_type>;
+			using node_pointer       = node_type*;
+			using const_node_pointer = const node_type*;
+			using allocator_type     = typename std::allocator_traits<Allocator>::template rebind_alloc<node_type>;
+
+			//node template of the tree (used by iterators)
+			template<class U>
+			using node_template = treap_node<U>;
+
+			//default constructor
+			treap()
+			{
+				new_head_node();
+			}
+
+			//copy constructor
+			treap(const treap& other)
+			{
+				new_head_node();
+
+				if ( !other.empty() )
+				{
+					impl.pseudo_head->left = node_type::copy_nodes(get_allocator(), other.get_root());
+
+					impl.pseudo_head->left->parent = impl.pseudo_head;
+				}
+
+				impl.sz = other.impl.sz;
+			}
+
+			//move constructor
+			treap(treap&& other) noexcept
+			{
+				new_head_node();
+
+				swap(other);
+			}
+
+			//range constructor
+			template<class InputIter>
+			treap(InputIter first, InputIter last)
+			{
+				new_head_node();
+
+				insert(first, last);
+			}
+
+			//constructor with initializer list
+			treap(std::initializer_list<value_type> init)
+			{
+				new_head_node();
+
+				insert(init);
+			}
+
+			//destructor
+			~treap()
+			{
+				clear();
+
+				node_type::delete_one_node(get_allocator(), impl.pseudo_head);
+			}
+
+			//copy assignment
+			treap& operator = (const treap& other)
+			{
+				if (this != &other)
+				{
+					clear();
+
+					if ( !other.empty() )
+					{
+						impl.pseudo_head->left = node_type::copy_nodes(get_allocator(), other.get_root());
+
+						impl.pseudo_head->left->parent = impl.pseudo_head;
+
+						impl.sz = other.impl.sz;
+					}
+				}
+
+				return *this;
+			}
+
+			//move assignment
+			treap& operator = (treap&& other) noexcept
+			{
+				clear();
+
+				swap(other);
+
+				return *this;
+			}
+
+			//assignment with initializer list
+			treap& operator = (std::initializer_list<value_type> init)
+			{
+				clear();
+
+				insert(init);
+
+				return *this;
+			}
+
+			//gets the number of elements of the tree
+			size_type size() const noexcept
+			{
+				return impl.sz;
+			}
+
+			//checks if the tree is empty
+			bool empty() const noexcept
+			{
+				return size() == 0;
+			}
+
+			//clears all elements of the tree
+			void clear() noexcept
+			{
+				clear(get_root());
+
+				impl.pseudo_head->left = nullptr;
+
+				impl.sz = 0;
+			}
+
+			//gets the max value of the tree
+			node_pointer max() const noexcept
+			{
+				return empty() ? impl.pseudo_head : node_type::max(get_root());
+			}
+
+			//gets the min value of the tree
+			node_pointer min() const noexcept
+			{
+				return empty() ? impl.pseudo_head : node_type::min(get_root());
+			}
+
+			//gets the height of the tree, -1 if the tree is empty (O(n), levelorder)
+			difference_type height() const
+			{
+				difference_type          h   { -1 };
+				std::queue<node_pointer> que {};
+
+				if ( !empty() )
+					que.push(get_root());
+
+				for ( ; !que.empty(); ++h)
+				{
+					for (auto n { que.size() }; 0 < n; --n)
+					{
+						auto ptr { que.front() };
+
+						que.pop();
+
+						if (ptr->left != nullptr)
+							que.push(ptr->left);
+
+						if (ptr->right != nullptr)
+							que.push(ptr->right);
+					}
+				}
+
+				return h;
+			}
+
+			//inserts an element into the tree (with copy semantics)
+			auto insert(const value_type& value)
+			{
+				return emplace_hint(nullptr, value);
+			}
+
+			//inserts an element into the tree (with move semantics)
+			auto insert(value_type&& value)
+			{
+				return emplace_hint(nullptr, std::move(value));
+			}
+
+			//inserts a range of elements [first, last) into the tree (each element is inserted with the previous one as the hint)
+			template<class InputIter>
+			void insert(InputIter first, InputIter last)
+			{
+				for (node_pointer hint { nullptr }; first != last; ++first)
+					hint = insert(hint, *first).first;
+			}
+
+			//inserts the elements of the initializer list into the tree
+			void insert(std::initializer_list<value_type> init)
+			{
+				insert(init.begin(), init.end());
+			}
+
+			//replaces the elements of the tree with n elements in ascending order (no equivalent ones) in O(n), gen() returns the next one
+			template<class Gen>
+			void assign_sorted(size_type n, Gen gen)
+			{
+				clear();
+
+				auto root { build_sorted(n, gen) };
+
+				impl.pseudo_head->left = root;
+				impl.sz                = n;
+
+				if (root != nullptr)
+					root->parent = impl.pseudo_head;
+			}
+
+			//replaces the elements of the tree with the sorted range [first, last) of forward iterators in O(n)
+			template<class ForwardIter>
+			void assign_sorted(ForwardIter first, ForwardIter last)
+			{
+				assign_sorted(static_cast<size_type>(std::distance(first, last)), [&first]() -> decltype(auto) { return *first++; });
+			}
+
+			//inserts an element into the tree near the hint position (the element is expected right before or after hint)
+			auto insert(node_pointer hint, const value_type& value)
+			{
+				return emplace_hint(hint, value);
+			}
+
+			auto insert(node_pointer hint, value_type&& value)
+			{
+				return emplace_hint(hint, std::move(value));
+			}
+
+			//inserts an element into the tree with its value constructed in-place
+			template<class... Args>
+			auto emplace(Args&&... args)
+			{
+				return emplace_hint(nullptr, std::forward<Args>(args)...);
+			}
+
+			//inserts an element into the tree with its value constructed in-place near the hint position (no hint if nullptr)
+			template<class... Args>
+			auto emplace_hint(node_pointer hint, Args&&... args)
+			{
+				static_assert(std::is_constructible_v<value_type, Args...>, "parameter types of function emplace() are not constructible to value_type");
+
+				auto ptr { node_type::new_node(get_allocator(), std::forward<Args>(args)...) };
+				auto pr  { find_location(hint, ptr->value) };
+
+				if ( !pr.second )
+				{
+					node_type::delete_one_node(get_allocator(), ptr);
+
+					return std::make_pair(pr.first, false);
+				}
+
+				attach(pr.first, ptr, pr.first == impl.pseudo_head || get_compare()(ptr->value, pr.first->value));
+
+				return std::make_pair(ptr, true);
+			}
+
+			//inserts an element after the elements with the equivalent value, the element is always inserted
+			template<class... Args>
+			node_pointer emplace_equal(Args&&... args)
+			{
+				auto  ptr    { node_type::new_node(get_allocator(), std::forward<Args>(args)...) };
+				auto  parent { impl.pseudo_head };
+				auto& cmp    { get_compare() };
+				bool  left   { true };
+
+				for (auto curr { get_root() }; curr != nullptr; curr = left ? curr->left : curr->right)
+				{
+					parent = curr;
+					left   = cmp(ptr->value, curr->value);
+				}
+
+				attach(parent, ptr, left);
+
+				return ptr;
+			}
+
+			node_pointer insert_equal(const value_type& value)
+			{
+				return emplace_equal(value);
+			}
+
+			node_pointer insert_equal(value_type&& value)
+			{
+				return emplace_equal(std::move(value));
+			}
+
+			//inserts a range of elements [first, last) into the tree, after the elements with the equivalent values
+			template<class InputIter>
+			void insert_equal(InputIter first, InputIter last)
+			{
+				for ( ; first != last; ++first)
+					emplace_equal(*first);
+			}
+
+			/*
+			 *	removes the element at pos from the tree, returns its successor
+			 *
+			 *	rotates pos down below the child with the higher priority until it has at most one child, then unlinks it
+			 */
+			node_pointer erase(node_pointer pos)
+			{
+				if (pos == nullptr || pos == impl.pseudo_head)
+					return impl.pseudo_head;
+
+				auto next { node_type::successor(pos) };
+
+				for ( ; pos->left != nullptr && pos->right != nullptr; )
+					rotate_up(pos->left->priority < pos->right->priority ? pos->right : pos->left);
+
+				auto child  { pos->left != nullptr ? pos->left : pos->right };
+				auto parent { pos->parent };
+
+				if (parent->left == pos)
+					parent->left  = child;
+				else
+					parent->right = child;
+
+				if (child != nullptr)
+					child->parent = parent;
+
+				node_type::delete_one_node(get_allocator(), pos);
+
+				--impl.sz;
+
+				return next;
+			}
+
+			//removes the element with the equivalent val from the tree
+			template<class Ty>
+			node_pointer erase(const Ty& val)
+			{
+				auto ptr { find(val) };
+
+				return ptr == nullptr ? impl.pseudo_head : erase(ptr);
+			}
+
+			//removes the elements in the range [first, last) from the tree, returns last
+			node_pointer erase(node_pointer first, node_pointer last)
+			{
+				if (last == nullptr)
+					last = impl.pseudo_head;
+
+				for ( ; first != nullptr && first != last && first != impl.pseudo_head; )
+					first = erase(first);
+
+				return last;
+			}
+
+			//gets the number of elements equivalent to val
+			template<class Ty>
+			size_type count(const Ty& val) const
+			{
+				size_type cnt { 0 };
+				auto&     cmp { get_compare() };
+
+				for (auto ptr { lower_bound(val) }; ptr != nullptr && ptr != impl.pseudo_head && !cmp(val, ptr->value); ptr = successor(ptr))
+					++cnt;
+
+				return cnt;
+			}
+
+			//gets the number of elements in the range [lo, hi), O(log n + k)
+			template<class Ty>
+			size_type count_range(const Ty& lo, const Ty& hi) const
+			{
+				size_type cnt { 0 };
+				auto&     cmp { get_compare() };
+
+				for (auto ptr { lower_bound(lo) }; ptr != nullptr && ptr != impl.pseudo_head && cmp(ptr->value, hi); ptr = successor(ptr))
+					++cnt;
+
+				return cnt;
+			}
+
+			//exchanges the elements of the tree with those of other
+			void swap(treap& other) noexcept
+			{
+				std::swap(impl.pseudo_head, other.impl.pseudo_head);
+				std::swap(impl.sz,          other.impl.sz);
+			}
+
+			//finds the element with the equivalent val of the tree
+			template<class Ty>
+			node_pointer find(const Ty& val) const
+			{
+				auto  ptr { get_root() };
+				auto& cmp { get_compare() };
+
+				for ( ; ptr != nullptr; )
+				{
+					if (cmp(ptr->value, val))
+						ptr = ptr->right;
+					else if (cmp(val, ptr->value))
+						ptr = ptr->left;
+					else
+						break;
+				}
+
+				return ptr;
+			}
+
+			//checks if there is an element with the equivalent val of the tree
+			template<class Ty>
+			bool contains(const Ty& val) const
+			{
+				return find(val) != nullptr;
+			}
+
+			//finds the first element with the key or value that is not less than val
+			template<class Ty>
+			node_pointer lower_bound(const Ty& val) const
+			{
+				node_pointer bound { nullptr };
+				auto&        cmp   { get_compare() };
+
+				for (auto ptr { get_root() }; ptr != nullptr; )
+				{
+					if (cmp(ptr->value, val))
+						ptr = ptr->right;
+					else
+					{
+						bound = ptr;
+						ptr   = ptr->left;
+					}
+				}
+
+				return bound;
+			}
+
+			//finds the first element with the key or value that is greater than val
+			template<class Ty>
+			node_pointer upper_bound(const Ty& val) const
+			{
+				node_pointer bound { nullptr };
+				auto&        cmp   { get_compare() };
+
+				for (auto ptr { get_root() }; ptr != nullptr; )
+				{
+					if (cmp(val, ptr->value))
+					{
+						bound = ptr;
+						ptr   = ptr->left;
+					}
+					else
+						ptr = ptr->right;
+				}
+
+				return bound;
+			}
+
+			//performs an inorder traversal (iterative, the height of a treap is only expected to be O(log n))
+			template<class Fn>
+			void inorder(Fn func) const
+			{
+				for (auto ptr { node_type::min(get_root()) }; ptr != nullptr && ptr != impl.pseudo_head; ptr = successor(ptr))
+					func(ptr->value);
+			}
+
+			//performs a levelorder traversal
+			template<class Fn>
+			void levelorder(Fn func) const
+			{
+				std::queue<node_pointer> que {};
+
+				if ( !empty() )
+					que.push(get_root());
+
+				for ( ; !que.empty(); que.pop())
+				{
+					auto ptr { que.front() };
+
+					func(ptr->value);
+
+					if (ptr->left != nullptr)
+						que.push(ptr->left);
+
+					if (ptr->right != nullptr)
+						que.push(ptr->right);
+				}
+			}
+
+			//performs an inorder traversal of the tree
+			template<class Fn>
+			void traverse(Fn func) const
+			{
+				inorder(func);
+			}
+
+			//finds the successor of the node pointed by ptr
+			node_pointer successor(node_pointer ptr) const noexcept
+			{
+				return node_type::successor(ptr);
+			}
+
+			//finds the predecessor of the node pointed by ptr
+			node_pointer predecessor(node_pointer ptr) const noexcept
+			{
+				return node_type::predecessor(ptr);
+			}
+
+			//gets the pointer pointing to the root node
+			node_pointer get_root() const noexcept
+			{
+				return impl.pseudo_head->left;
+			}
+
+		private:
+			//creates the pseudo head node, its left child is the root node and its parent is itself
+			node_pointer new_head_node()
+			{
+				auto ptr { node_type::new_node(get_allocator()) };
+
+				impl.pseudo_head = ptr->parent = ptr;
+
+				return ptr;
+			}
+
+			//attaches the new node as the left or right child of the parent node with a random priority, then rotates it up to restore the heap order
+			void attach(node_pointer parent, node_pointer ptr, bool left) noexcept
+			{
+				ptr->parent   = parent;
+				ptr->priority = next_priority();
+
+				if (left)
+					parent->left  = ptr;
+				else
+					parent->right = ptr;
+
+				++impl.sz;
+
+				for ( ; ptr->parent != impl.pseudo_head && ptr->parent->priority < ptr->priority; )
+					rotate_up(ptr);
+			}
+
+			//rotates the node pointed by ptr above its parent node
+			void rotate_up(node_pointer ptr) noexcept
+			{
+				auto parent      { ptr->parent };
+				auto grandparent { parent->parent };
+
+				if (parent->left == ptr)
+				{
+					parent->left = ptr->right;
+
+					if (ptr->right != nullptr)
+						ptr->right->parent = parent;
+
+					ptr->right = parent;
+				}
+				else
+				{
+					parent->right = ptr->left;
+
+					if (ptr->left != nullptr)
+						ptr->left->parent = parent;
+
+					ptr->left = parent;
+				}
+
+				parent->parent = ptr;
+				ptr->parent    = grandparent;
+
+				if (grandparent->left == parent)
+					grandparent->left  = ptr;
+				else
+					grandparent->right = ptr;
+			}
+
+			//gets the next random priority (xorshift32)
+			std::uint32_t next_priority() noexcept
+			{
+				auto x { impl.seed };
+
+				x ^= x << 13;
+				x ^= x >> 17;
+				x ^= x << 5;
+
+				return impl.seed = x;
+			}
+
+			/*
+			 *	finds the location to insert a new element, next to the hint node if the hint is right
+			 *
+			 *	return value:
+			 *					(the pseudo head node if the tree is empty,                   true)
+			 *					(pointer pointing to the parent node of the possible new node, true)
+			 *					(pointer pointing to the node with duplicate value,            false)
+			 */
+			template<class Ty>
+			std::pair<node_pointer, bool> find_location(node_pointer hint, const Ty& val) const
+			{
+				auto& cmp { get_compare() };
+
+				if (empty())
+					return std::make_pair(impl.pseudo_head, true);
+
+				if (hint != nullptr)
+				{
+					if (hint == impl.pseudo_head || cmp(val, hint->value))
+					{
+						auto prev { node_type::predecessor(hint) };
+
+						//the predecessor of the min node is the pseudo head node
+						if (prev == impl.pseudo_head || cmp(prev->value, val))
+							return std::make_pair(hint == impl.pseudo_head || hint->left != nullptr ? prev : hint, true);
+					}
+					else if (cmp(hint->value, val))
+					{
+						auto next { node_type::successor(hint) };
+
+						if (next == impl.pseudo_head || cmp(val, next->value))
+							return std::make_pair(hint->right != nullptr ? next : hint, true);
+					}
+					else
+						return std::make_pair(hint, false);
+				}
+
+				auto ptr { get_root() }, prev { ptr };
+
+				for ( ; ptr != nullptr; )
+				{
+					prev = ptr;
+
+					if (cmp(ptr->value, val))
+						ptr = ptr->right;
+					else if (cmp(val, ptr->value))
+						ptr = ptr->left;
+					else
+						return std::make_pair(ptr, false);
+				}
+
+				return std::make_pair(prev, true);
+			}
+
+			/*
+			 *	builds the treap of n elements produced by gen() in order with random priorities in O(n)
+			 *
+			 *	keeps the right spine on a stack, a new node takes the popped nodes of lower priority as its left subtree
+			 *	and becomes the right child of the top of the stack
+			 */
+			template<class Gen>
+			node_pointer build_sorted(size_type n, Gen& gen)
+			{
+				std::vector<node_pointer> spine {};
+
+				try
+				{
+					for ( ; 0 < n; --n)
+					{
+						auto         ptr  { node_type::new_node(get_allocator(), gen()) };
+						node_pointer last { nullptr };
+
+						ptr->priority = next_priority();
+
+						for ( ; !spine.empty() && spine.back()->priority < ptr->priority; spine.pop_back())
+							last = spine.back();
+
+						ptr->left = last;
+
+						if (last != nullptr)
+							last->parent = ptr;
+
+						if ( !spine.empty() )
+						{
+							spine.back()->right = ptr;
+							ptr->parent         = spine.back();
+						}
+
+						spine.push_back(ptr);
+					}
+				}
+				catch (...)
+				{
+					//the nodes built so far form a treap rooted in the bottom of the stack
+					if ( !spine.empty() )
+						clear(spine.front());
+
+					throw;
+				}
+
+				return spine.empty() ? nullptr : spine.front();
+			}
+
+			//clears all elements of the subtree rooted in the ptr node (rotates the left child up, no recursion)
+			void clear(node_pointer ptr) noexcept
+			{
+				for (node_pointer tmp { nullptr }; ptr != nullptr; )
+				{
+					if (ptr->left != nullptr)
+					{
+						tmp        = ptr->left;
+						ptr->left  = tmp->right;
+						tmp->right = ptr;
+					}
+					else
+					{
+						tmp = ptr->right;
+
+						node_type::delete_one_node(get_allocator(), ptr);
+					}
+
+					ptr = tmp;
+				}
+			}
+
+			//gets the allocator
+			allocator_type& get_allocator() noexcept
+			{
+				return impl;
+			}
+
+			const allocator_type& get_allocator() const noexcept
+			{
+				return impl;
+			}
+
+			//gets the compare function object
+			Compare& get_compare() noexcept
+			{
+				return impl;
+			}
+
+			const Compare& get_compare() const noexcept
+			{
+				return impl;
+			}
+
+			//implementation type
+			struct impl_type : public Compare, allocator_type
+			{
+				node_pointer  pseudo_head { nullptr };			//a pointer pointing to pseudo head node
+				size_type     sz          { 0 };				//the number of elements of the tree
+				std::uint32_t seed        { 2463534242 };			//the state of the priority generator
+			};
+
+			impl_type impl {};							//implementation of treap
+	};
+}
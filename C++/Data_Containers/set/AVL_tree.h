@@ -5,16 +5,193 @@
 #include <type_traits>
 #include <utility>
 #include <initializer_list>
+#include <iterator>
 #include <queue>
+#include <future>
+#include <thread>
+#include <tuple>
 
 namespace cust					//customized / non-standard
 {
-	template<class T>
+	/*
+	 *	augmentation policy of AVL tree, keeps a summary of the subtree rooted in each node
+	 *
+	 *	a policy provides:
+	 *			summary_type                                              type of the summary (a monoid)
+	 *			static summary_type identity()                            summary of an empty subtree
+	 *			static summary_type lift(const value_type& value)         summary of a single element
+	 *			static summary_type combine(const summary_type& lhs,      associative operation of two summaries
+	 *			                            const summary_type& rhs)      (lhs comes before rhs in order)
+	 *
+	 *	no_augment is the default policy, it keeps nothing and compiles away
+	 */
+	struct no_augment
+	{
+		struct summary_type {};
+
+		template<class T>
+		static constexpr summary_type lift(const T&) noexcept
+		{
+			return {};
+		}
+
+		static constexpr summary_type identity() noexcept
+		{
+			return {};
+		}
+
+		static constexpr summary_type combine(const summary_type&, const summary_type&) noexcept
+		{
+			return {};
+		}
+	};
+
+	//augmentation policy: the number of elements of the subtree rooted in each node (counts a key range in O(log n))
+	struct subtree_size
+	{
+		using summary_type = std::size_t;
+
+		template<class T>
+		static constexpr summary_type lift(const T&) noexcept
+		{
+			return 1;
+		}
+
+		static constexpr summary_type identity() noexcept
+		{
+			return 0;
+		}
+
+		static constexpr summary_type combine(summary_type lhs, summary_type rhs) noexcept
+		{
+			return lhs + rhs;
+		}
+	};
+
+	//the direction of a rotation to rebalance a node
+	enum class rotate_to : char { left, right, nowhere };
+
+	/*
+	 *	statistics policy of AVL tree, its hooks are called by the tree:
+	 *
+	 *			void on_compare()                                    a comparison of two elements
+	 *			void on_rotation(rotate_to direction, bool twice)    a rotation (twice: a double rotation, the inner one first)
+	 *			void on_allocate(std::size_t n)                      n nodes allocated
+	 *			void on_deallocate(std::size_t n)                    n nodes freed
+	 *			void on_lookup(std::size_t length)                   a search from the root visited length nodes
+	 *			void reset()                                         clears the counters (by reset_stats() of the tree)
+	 *
+	 *	no_stats is the default policy, its hooks are empty and compile away
+	 */
+	struct no_stats
+	{
+		constexpr void on_compare() const noexcept {}
+		constexpr void on_rotation(rotate_to, bool) const noexcept {}
+		constexpr void on_allocate(std::size_t) const noexcept {}
+		constexpr void on_deallocate(std::size_t) const noexcept {}
+		constexpr void on_lookup(std::size_t) const noexcept {}
+		constexpr void reset() noexcept {}
+	};
+
+	/*
+	 *	statistics policy: counts comparisons, rotations, allocations and deallocations of nodes,
+	 *	and keeps the max depth and a histogram of the lengths of the search paths (find, lower_bound, upper_bound, insert)
+	 *
+	 *	the counters are updated by const lookups too, so a tree with tree_stats must not be read by several threads at the same time
+	 *	(the set operations do not fork with it)
+	 */
+	struct tree_stats
+	{
+		static constexpr std::size_t max_path_length { 64 };		//the last bucket of the histogram counts the longer paths too
+
+		void on_compare() const noexcept
+		{
+			++comparisons;
+		}
+
+		void on_rotation(rotate_to direction, bool twice) const noexcept
+		{
+			++(twice ? double_rotations : rotations)[static_cast<std::size_t>(direction)];
+		}
+
+		void on_allocate(std::size_t n) const noexcept
+		{
+			allocations += n;
+		}
+
+		void on_deallocate(std::size_t n) const noexcept
+		{
+			deallocations += n;
+		}
+
+		void on_lookup(std::size_t length) const noexcept
+		{
+			++path_lengths[std::min(length, max_path_length - 1)];
+
+			max_depth = std::max(max_depth, length);
+		}
+
+		/*
+		 *	clears the counters of comparisons and rotations, the max depth and the histogram of the search paths,
+		 *	allocations and deallocations are kept, so live_nodes() stays the number of nodes of the tree
+		 */
+		void reset() noexcept
+		{
+			auto alloc   { allocations };
+			auto dealloc { deallocations };
+
+			*this = tree_stats {};
+
+			allocations   = alloc;
+			deallocations = dealloc;
+		}
+
+		//gets the number of nodes allocated and not freed (including the pseudo head node)
+		std::size_t live_nodes() const noexcept
+		{
+			return allocations - deallocations;
+		}
+
+		//gets the number of searches from the root
+		std::size_t lookups() const noexcept
+		{
+			std::size_t cnt { 0 };
+
+			for (auto n : path_lengths)
+				cnt += n;
+
+			return cnt;
+		}
+
+		mutable std::size_t comparisons                     { 0 };
+		mutable std::size_t rotations[2]                    {};		//single rotations, [rotate_to::left] and [rotate_to::right]
+		mutable std::size_t double_rotations[2]             {};		//right-left ([rotate_to::left]) and left-right ([rotate_to::right])
+		mutable std::size_t allocations                     { 0 };
+		mutable std::size_t deallocations                   { 0 };
+		mutable std::size_t max_depth                       { 0 };		//the longest search path (the number of nodes visited)
+		mutable std::size_t path_lengths[max_path_length]   {};		//the number of searches by the number of nodes visited
+	};
+
+	//compare function object which reports each comparison to the statistics policy (a plain forwarding call with no_stats)
+	template<class Compare, class Stats>
+	struct stats_compare : public Compare, Stats
+	{
+		template<class L, class R>
+		constexpr bool operator () (const L& lhs, const R& rhs) const
+		{
+			Stats::on_compare();
+
+			return Compare::operator()(lhs, rhs);
+		}
+	};
+
+	template<class T, class Augment = no_augment>
 	struct AVL_tree_node
 	{
 		using value_type      = T;
 		using difference_type = long long;
 		using node_pointer    = AVL_tree_node*;
+		using summary_type    = typename Augment::summary_type;
 
 		//adds a tree node by allocating memory space and calling its constructor
 		template<class Allocator, class... Args>
@@ -25,6 +202,7 @@ namespace cust					//customized / non-standard
 			ptr->parent = ptr->right = ptr->left = nullptr;
 			ptr->height = 0;
 			std::allocator_traits<Allocator>::construct(alloc, std::addressof(ptr->value), std::forward<Args>(args)...);
+			std::allocator_traits<Allocator>::construct(alloc, std::addressof(ptr->summary));
 
 			return ptr;
 		}
@@ -39,6 +217,7 @@ namespace cust					//customized / non-standard
 			ptr->parent = p;
 			ptr->height = h;
 			std::allocator_traits<Allocator>::construct(alloc, std::addressof(ptr->value), std::forward<Args>(args)...);
+			std::allocator_traits<Allocator>::construct(alloc, std::addressof(ptr->summary));
 
 			return ptr;
 		}
@@ -71,26 +250,61 @@ namespace cust					//customized / non-standard
 			std::allocator_traits<Allocator>::deallocate(alloc, ptr, 1);
 		}
 
-		//copies the subtree rooted in the src node
+		/*
+		 *	copies the subtree rooted in the src node
+		 *
+		 *	walks the source subtree and its copy side by side without recursion, the parent pointers lead the way back up
+		 */
 		template<class Allocator>
 		[[nodiscard]] static node_pointer copy_nodes(Allocator& alloc, node_pointer src)
 		{
-			node_pointer ptr { nullptr };
+			if (src == nullptr)
+				return nullptr;
 
-			if (src != nullptr)
+			auto root { new_one_node(alloc, nullptr, nullptr, nullptr, src->height, src->value) };
+
+			for (auto ptr { root }; ; )
 			{
-				ptr = new_one_node(alloc, copy_nodes(alloc, src->left), copy_nodes(alloc, src->right), nullptr, src->height, src->value);
+				if (src->left != nullptr && ptr->left == nullptr)
+				{
+					src = src->left;
+					ptr = ptr->left  = new_one_node(alloc, nullptr, nullptr, ptr, src->height, src->value);
+				}
+				else if (src->right != nullptr && ptr->right == nullptr)
+				{
+					src = src->right;
+					ptr = ptr->right = new_one_node(alloc, nullptr, nullptr, ptr, src->height, src->value);
+				}
+				else
+				{
+					//both subtrees are copied, the summary is recomputed instead of copied (it may refer to the source nodes)
+					update_summary(ptr);
 
-				//has the left  child
-				if (ptr->left != nullptr)
-					ptr->left->parent = ptr;
+					if (ptr == root)
+						break;
 
-				//has the right child
-				if (ptr->right != nullptr)
-					ptr->right->parent = ptr;
+					src = src->parent;
+					ptr = ptr->parent;
+				}
 			}
 
-			return ptr;
+			return root;
+		}
+
+		//gets the summary of the subtree rooted in the ptr node
+		static summary_type get_summary(const AVL_tree_node* ptr)
+		{
+			if constexpr (std::is_same_v<Augment, no_augment>)
+				return {};
+			else
+				return ptr == nullptr ? Augment::identity() : ptr->summary;
+		}
+
+		//recomputes the summary of the node pointed by ptr from its children
+		static void update_summary(node_pointer ptr)
+		{
+			if constexpr ( !std::is_same_v<Augment, no_augment> )
+				ptr->summary = Augment::combine(Augment::combine(get_summary(ptr->left), Augment::lift(ptr->value)), get_summary(ptr->right));
 		}
 
 		//finds the node with the max value of the subtree rooted in the parent node
@@ -168,9 +382,11 @@ namespace cust					//customized / non-standard
 		node_pointer    parent { nullptr };			//pointer pointing to parent      node
 		difference_type height { 0 };				//height of the node
 		value_type      value  {};
+
+		[[no_unique_address]] summary_type summary {};		//summary of the subtree rooted in the node
 	};
 
-	template<class T, class Compare = std::less<T>, class Allocator = std::allocator<T>>
+	template<class T, class Compare = std::less<T>, class Allocator = std::allocator<T>, class Augment = no_augment, class Stats = no_stats>
 	class AVL_tree
 	{
 		public:
@@ -181,10 +397,22 @@ namespace cust					//customized / non-standard
 			using const_pointer      = const value_type*;
 			using reference          = value_type&;
 			using const_reference    = const value_type&;
-			using node_type          = AVL_tree_node<value_type>;
+			using node_type          = AVL_tree_node<value_type, Augment>;
 			using node_pointer       = node_type*;
 			using const_node_pointer = const node_type*;
 			using allocator_type     = typename std::allocator_traits<Allocator>::template rebind_alloc<node_type>;
+			using summary_type       = typename Augment::summary_type;
+			using stats_type         = Stats;
+
+			//node template of the tree (used by iterators)
+			template<class U>
+			using node_template = AVL_tree_node<U, Augment>;
+
+			//the min number of elements of a tree to copy by two threads
+			static constexpr size_type parallel_copy_threshold { 1 << 16 };
+
+			//the min height of a subtree to fork a set operation on its left subtree
+			static constexpr difference_type parallel_subtree_height { 12 };
 
 			//default constructor
 			AVL_tree()
@@ -201,7 +429,9 @@ namespace cust					//customized / non-standard
 				if ( !other.empty() )
 				{
 					//root node is the left child node of the pseudo head node
-					impl.pseudo_head->left = node_type::copy_nodes(get_allocator(), other.get_root());
+					impl.pseudo_head->left = copy_tree(other.get_root(), other.size());
+
+					get_stats().on_allocate(other.size());
 
 					impl.pseudo_head->left->parent = impl.pseudo_head;		//pseudo head node is the parent node of root node
 				}
@@ -241,7 +471,7 @@ namespace cust					//customized / non-standard
 			{
 				clear();
 
-				node_type::delete_one_node(get_allocator(), impl.pseudo_head);
+				delete_node(impl.pseudo_head);
 			}
 
 			//copy assignment
@@ -251,7 +481,9 @@ namespace cust					//customized / non-standard
 
 				if ( !other.empty() )
 				{
-					impl.pseudo_head->left = node_type::copy_nodes(get_allocator(), other.get_root());
+					impl.pseudo_head->left = copy_tree(other.get_root(), other.size());
+
+					get_stats().on_allocate(other.size());
 
 					impl.pseudo_head->left->parent = impl.pseudo_head;
 
@@ -355,12 +587,12 @@ namespace cust					//customized / non-standard
 				return std::make_pair(pr.first, pr.second);
 			}
 
-			//inserts a range of elements [first, last) into the tree
+			//inserts a range of elements [first, last) into the tree (each element is inserted with the previous one as the hint)
 			template<class InputIter>
 			void insert(InputIter first, InputIter last)
 			{
-				for ( ; first != last; ++first)
-					insert(*first);
+				for (node_pointer hint { nullptr }; first != last; ++first)
+					hint = insert(hint, *first).first;
 			}
 
 			//inserts the elements of the initializer list into the tree
@@ -369,14 +601,84 @@ namespace cust					//customized / non-standard
 				insert(init.begin(), init.end());
 			}
 
+			/*
+			 *	replaces the elements of the tree with n elements in ascending order (no equivalent ones) in O(n)
+			 *
+			 *	gen() returns the next element, the tree is built in order and balanced by the halves of n (no comparison, no rotation)
+			 */
+			template<class Gen>
+			void assign_sorted(size_type n, Gen gen)
+			{
+				clear();
+
+				auto root { build_sorted(n, gen) };
+
+				impl.pseudo_head->left = root;
+				impl.sz                = n;
+
+				if (root != nullptr)
+					root->parent = impl.pseudo_head;
+			}
+
+			//replaces the elements of the tree with the sorted range [first, last) of forward iterators in O(n)
+			template<class ForwardIter>
+			void assign_sorted(ForwardIter first, ForwardIter last)
+			{
+				assign_sorted(static_cast<size_type>(std::distance(first, last)), [&first]() -> decltype(auto) { return *first++; });
+			}
+
+			/*
+			 *	inserts an element into the tree near the hint position (the element is expected right before or after hint)
+			 *
+			 *	two comparisons if the hint is right (e.g. ascending keys with hint end), a full descent from the root otherwise
+			 */
+			auto insert(node_pointer hint, const value_type& value)
+			{
+				auto pr { find_location(hint, value) };
+
+				if (pr.second)
+				{
+					pr.first = (pr.first == nullptr ? add_root(value) : append_child(pr.first, value));
+
+					++impl.sz;
+
+					update_height(pr.first);
+				}
+
+				return std::make_pair(pr.first, pr.second);
+			}
+
+			auto insert(node_pointer hint, value_type&& value)
+			{
+				auto pr { find_location(hint, value) };
+
+				if (pr.second)
+				{
+					pr.first = (pr.first == nullptr ? add_root(std::move(value)) : append_child(pr.first, std::move(value)));
+
+					++impl.sz;
+
+					update_height(pr.first);
+				}
+
+				return std::make_pair(pr.first, pr.second);
+			}
+
 			//inserts an element into the tree with its value constructed in-place
 			template<class... Args>
 			auto emplace(Args&&... args)
+			{
+				return emplace_hint(nullptr, std::forward<Args>(args)...);
+			}
+
+			//inserts an element into the tree with its value constructed in-place near the hint position (no hint if nullptr)
+			template<class... Args>
+			auto emplace_hint(node_pointer hint, Args&&... args)
 			{
 				static_assert(std::is_constructible_v<value_type, Args...>, "parameter types of function emplace() are not constructible to value_type");
 
-				auto  ptr { node_type::new_node(get_allocator(), std::forward<Args>(args)...) };
-				auto  pr  { find_location(ptr->value) };
+				auto  ptr { new_node(std::forward<Args>(args)...) };
+				auto  pr  { find_location(hint, ptr->value) };
 				auto& cmp { get_compare() };
 
 				if (pr.second)
@@ -403,7 +705,7 @@ namespace cust					//customized / non-standard
 					update_height(pr.first);
 				}
 				else
-					node_type::delete_one_node(get_allocator(), ptr);
+					delete_node(ptr);
 
 				return std::make_pair(pr.first, pr.second);
 			}
@@ -425,6 +727,121 @@ namespace cust					//customized / non-standard
 				return erase(find(val));
 			}
 
+			/*
+			 *	removes the elements in the range [first, last) from the tree in O(log n + k)
+			 *
+			 *	splits the tree at first and at last, clears the middle part and joins the rest with the last node
+			 *	(no rebalancing after each removal, equivalent elements are split by their positions), returns last
+			 */
+			node_pointer erase(node_pointer first, node_pointer last)
+			{
+				if (last == nullptr)
+					last = impl.pseudo_head;
+
+				if (first == nullptr || first == impl.pseudo_head || first == last)
+					return last;
+
+				auto [less, lo, rest] = split_at(first);
+				auto  root { less };
+				auto  cnt  { size_type { 1 } };
+
+				delete_node(lo);
+
+				if (last == impl.pseudo_head)
+					cnt += clear(rest);
+				else
+				{
+					rest->parent = impl.pseudo_head;
+
+					auto [mid, hi, greater] = split_at(last);
+
+					cnt += clear(mid);
+					root = join(less, hi, greater);
+				}
+
+				impl.pseudo_head->left = root;
+				impl.sz               -= cnt;
+
+				if (root != nullptr)
+					root->parent = impl.pseudo_head;
+
+				return last;
+			}
+
+			/*
+			 *	inserts an element after the elements with the equivalent value, the element is always inserted
+			 *	(equivalent elements keep the order of insertion, e.g. for a multimap or a multiset)
+			 */
+			template<class... Args>
+			node_pointer emplace_equal(Args&&... args)
+			{
+				auto  ptr    { new_node(std::forward<Args>(args)...) };
+				auto  parent { impl.pseudo_head };
+				auto& cmp    { get_compare() };
+				bool  left   { true };
+
+				for (auto curr { get_root() }; curr != nullptr; curr = left ? curr->left : curr->right)
+				{
+					parent = curr;
+					left   = cmp(ptr->value, curr->value);
+				}
+
+				ptr->parent = parent;
+
+				if (left)
+					parent->left  = ptr;
+				else
+					parent->right = ptr;
+
+				++impl.sz;
+
+				update_height(ptr);
+
+				return ptr;
+			}
+
+			node_pointer insert_equal(const value_type& value)
+			{
+				return emplace_equal(value);
+			}
+
+			node_pointer insert_equal(value_type&& value)
+			{
+				return emplace_equal(std::move(value));
+			}
+
+			//inserts a range of elements [first, last) into the tree, after the elements with the equivalent values
+			template<class InputIter>
+			void insert_equal(InputIter first, InputIter last)
+			{
+				for ( ; first != last; ++first)
+					emplace_equal(*first);
+			}
+
+			/*
+			 *	gets the number of elements equivalent to val
+			 *
+			 *	O(log n) with the subtree_size augmentation (the difference of two ranks), O(log n + k) otherwise
+			 */
+			template<class Ty>
+			size_type count(const Ty& val) const
+			{
+				if constexpr (std::is_same_v<Augment, subtree_size>)
+				{
+					return rank(val, true) - rank(val, false);
+				}
+				else
+				{
+					size_type cnt { 0 };
+					auto&     cmp { get_compare() };
+
+					for (auto ptr { lower_bound(val) }; ptr != nullptr && ptr != impl.pseudo_head && !cmp(val, ptr->value); ptr = successor(ptr))
+						++cnt;
+
+					return cnt;
+				}
+			}
+
 			//exchanges the elements of the tree with those of other
 			void swap(AVL_tree& other) noexcept
 			{
@@ -452,10 +869,11 @@ namespace cust					//customized / non-standard
 			template<class Ty>
 			node_pointer lower_bound(const Ty& val) const
 			{
-				node_pointer bound { nullptr };
-				auto&        cmp   { get_compare() };
+				node_pointer bound  { nullptr };
+				auto&        cmp    { get_compare() };
+				size_type    length { 0 };
 
-				for (auto ptr { get_root() }; ptr != nullptr; )
+				for (auto ptr { get_root() }; ptr != nullptr; ++length)
 				{
 					if (cmp(ptr->value, val))
 						ptr = ptr->right;
@@ -466,6 +884,8 @@ namespace cust					//customized / non-standard
 					}
 				}
 
+				get_stats().on_lookup(length);
+
 				return bound;
 			}
 
@@ -473,10 +893,11 @@ namespace cust					//customized / non-standard
 			template<class Ty>
 			node_pointer upper_bound(const Ty& val) const
 			{
-				node_pointer bound { nullptr };
-				auto&        cmp   { get_compare() };
+				node_pointer bound  { nullptr };
+				auto&        cmp    { get_compare() };
+				size_type    length { 0 };
 
-				for (auto ptr { get_root() }; ptr != nullptr; )
+				for (auto ptr { get_root() }; ptr != nullptr; ++length)
 				{
 					if (cmp(val, ptr->value))
 					{
@@ -487,6 +908,8 @@ namespace cust					//customized / non-standard
 						ptr = ptr->right;
 				}
 
+				get_stats().on_lookup(length);
+
 				return bound;
 			}
 
@@ -557,41 +980,215 @@ namespace cust					//customized / non-standard
 				return node_type::predecessor(ptr);
 			}
 
-		private:
-			enum class rotate_to : char { left, right, nowhere };
+			//gets the summary of all elements of the tree
+			summary_type summary() const
+			{
+				return node_type::get_summary(get_root());
+			}
 
-			//new a pseudo head node
-			node_pointer new_head_node()
+			/*
+			 *	gets the summary of the elements in the range [lo, hi) in O(log n)
+			 *
+			 *	1. finds the split node, the highest node in the range
+			 *	2. walks down its left  subtree, collects the nodes not less than lo and their right subtrees
+			 *	3. walks down its right subtree, collects the nodes less than hi and their left subtrees
+			 */
+			template<class Ty>
+			summary_type accumulate(const Ty& lo, const Ty& hi) const
 			{
-				auto ptr { node_type::new_node(get_allocator()) };
+				auto& cmp   { get_compare() };
+				auto  split { get_root() };
 
-				impl.pseudo_head = ptr->parent = ptr;
+				for ( ; split != nullptr; )
+				{
+					if (cmp(split->value, lo))
+						split = split->right;
+					else if ( !cmp(split->value, hi) )
+						split = split->left;
+					else
+						break;
+				}
 
-				return ptr;
+				if (split == nullptr)
+					return Augment::identity();
+
+				auto lsum { Augment::identity() };
+				auto rsum { Augment::identity() };
+
+				for (auto ptr { split->left }; ptr != nullptr; )
+				{
+					if (cmp(ptr->value, lo))
+						ptr = ptr->right;
+					else
+					{
+						lsum = Augment::combine(Augment::combine(Augment::lift(ptr->value), node_type::get_summary(ptr->right)), lsum);
+						ptr  = ptr->left;
+					}
+				}
+
+				for (auto ptr { split->right }; ptr != nullptr; )
+				{
+					if (cmp(ptr->value, hi))
+					{
+						rsum = Augment::combine(rsum, Augment::combine(node_type::get_summary(ptr->left), Augment::lift(ptr->value)));
+						ptr  = ptr->right;
+					}
+					else
+						ptr = ptr->left;
+				}
+
+				return Augment::combine(Augment::combine(lsum, Augment::lift(split->value)), rsum);
 			}
 
-			//adds the root node if the tree is empty
-			template<class... Args>
-			node_pointer add_root(Args&&... args)
+			/*
+			 *	gets the number of elements in the range [lo, hi)
+			 *
+			 *	O(log n) with the subtree_size augmentation (the sizes of the subtrees are summed up by accumulate)
+			 *	O(log n + k) otherwise (walks from lower bound of lo to the first element not less than hi)
+			 */
+			template<class Ty>
+			size_type count_range(const Ty& lo, const Ty& hi) const
 			{
-				if (empty() && impl.pseudo_head->left == nullptr)
-					impl.pseudo_head->left = node_type::new_one_node(get_allocator(), nullptr, nullptr, impl.pseudo_head, 0, std::forward<Args>(args)...);
+				if constexpr (std::is_same_v<Augment, subtree_size>)
+				{
+					return accumulate(lo, hi);
+				}
+				else
+				{
+					size_type cnt { 0 };
+					auto&     cmp { get_compare() };
 
-				return impl.pseudo_head->left;
+					for (auto ptr { lower_bound(lo) }; ptr != nullptr && ptr != impl.pseudo_head && cmp(ptr->value, hi); ptr = successor(ptr))
+						++cnt;
+
+					return cnt;
+				}
 			}
 
-			//appends a left child node to the parent node pointed by ptr
-			template<class... Args>
-			node_pointer append_left(node_pointer ptr, Args&&... args)
+			//recomputes the summaries of the node pointed by ptr and its ancestral nodes after its value is modified in place
+			void update_summary(node_pointer ptr)
 			{
-				return node_type::append_left(get_allocator(), ptr, std::forward<Args>(args)...);
+				for ( ; ptr != nullptr && ptr != impl.pseudo_head; ptr = ptr->parent)
+					node_type::update_summary(ptr);
 			}
 
-			//appends a right child node to the parent node pointed by ptr
-			template<class... Args>
-			node_pointer append_right(node_pointer ptr, Args&&... args)
+			//gets the pointer pointing to the root node
+			node_pointer get_root() const noexcept
+			{
+				return impl.pseudo_head->left;
+			}
+
+			//gets the statistics of the tree (an empty no_stats object unless the tree is instrumented)
+			const Stats& stats() const noexcept
+			{
+				return get_stats();
+			}
+
+			//resets the statistics of the tree (see the reset() of the statistics policy, tree_stats keeps the allocation counters)
+			void reset_stats() noexcept
+			{
+				static_cast<Stats&>(impl).reset();
+			}
+
+			/*
+			 *	set operations based on split and join, the result is kept in this tree and other becomes empty
+			 *
+			 *	O(m log(n / m + 1)) for the sizes m <= n, the subtrees of large trees are processed by forked threads
+			 *	no node is allocated or copied, the nodes are moved from other (the allocators must compare equal)
+			 */
+
+			//keeps the elements in this tree or other (the element of this tree is kept if both have it)
+			void union_with(AVL_tree& other)
+			{
+				set_operation_with(other, set_operation::union_of);
+			}
+
+			//keeps the elements in both this tree and other
+			void intersection_with(AVL_tree& other)
+			{
+				set_operation_with(other, set_operation::intersection);
+			}
+
+			//keeps the elements in this tree but not in other
+			void difference_with(AVL_tree& other)
+			{
+				set_operation_with(other, set_operation::difference);
+			}
+
+			//keeps the elements in either this tree or other but not in both
+			void symmetric_difference_with(AVL_tree& other)
+			{
+				set_operation_with(other, set_operation::symmetric_difference);
+			}
+
+		private:
+			enum class set_operation : char { union_of, intersection, difference, symmetric_difference };
+
+			using compare_type = stats_compare<Compare, Stats>;
+
+			//allocates a node (counted by the statistics policy)
+			template<class... Args>
+			node_pointer new_node(Args&&... args)
+			{
+				auto ptr { node_type::new_node(get_allocator(), std::forward<Args>(args)...) };
+
+				get_stats().on_allocate(1);
+
+				return ptr;
+			}
+
+			//frees a node (counted by the statistics policy)
+			void delete_node(node_pointer ptr) noexcept
 			{
-				return node_type::append_right(get_allocator(), ptr, std::forward<Args>(args)...);
+				node_type::delete_one_node(get_allocator(), ptr);
+
+				get_stats().on_deallocate(1);
+			}
+
+			//new a pseudo head node
+			node_pointer new_head_node()
+			{
+				auto ptr { new_node() };
+
+				impl.pseudo_head = ptr->parent = ptr;
+
+				return ptr;
+			}
+
+			//adds the root node if the tree is empty
+			template<class... Args>
+			node_pointer add_root(Args&&... args)
+			{
+				if (empty() && impl.pseudo_head->left == nullptr)
+				{
+					impl.pseudo_head->left = node_type::new_one_node(get_allocator(), nullptr, nullptr, impl.pseudo_head, 0, std::forward<Args>(args)...);
+
+					get_stats().on_allocate(1);
+				}
+
+				return impl.pseudo_head->left;
+			}
+
+			//appends a left child node to the parent node pointed by ptr
+			template<class... Args>
+			node_pointer append_left(node_pointer ptr, Args&&... args)
+			{
+				auto child { node_type::append_left(get_allocator(), ptr, std::forward<Args>(args)...) };
+
+				get_stats().on_allocate(1);
+
+				return child;
+			}
+
+			//appends a right child node to the parent node pointed by ptr
+			template<class... Args>
+			node_pointer append_right(node_pointer ptr, Args&&... args)
+			{
+				auto child { node_type::append_right(get_allocator(), ptr, std::forward<Args>(args)...) };
+
+				get_stats().on_allocate(1);
+
+				return child;
 			}
 
 			//appends a child node to the parent node (with copy semantics)
@@ -680,23 +1277,99 @@ namespace cust					//customized / non-standard
 						pos->parent->right = ptr;
 				}
 
-				node_type::delete_one_node(get_allocator(), pos);
+				delete_node(pos);
 
 				--impl.sz;
 
 				return std::make_pair(next, tmp);
 			}
 
-			//clear all elements of the subtree rooted in the ptr node
-			void clear(node_pointer ptr) noexcept
+			/*
+			 *	clears all elements of the subtree rooted in the ptr node, returns the number of elements cleared
+			 *
+			 *	rotates the left child up until the node has no left child, then deletes the node and goes on with its right child
+			 *	(no recursion and no extra space, whatever the shape of the subtree is)
+			 */
+			size_type clear(node_pointer ptr) noexcept
 			{
-				if (ptr != nullptr)
+				size_type cnt { 0 };
+
+				for (node_pointer tmp { nullptr }; ptr != nullptr; )
+				{
+					if (ptr->left != nullptr)
+					{
+						tmp        = ptr->left;
+						ptr->left  = tmp->right;
+						tmp->right = ptr;
+					}
+					else
+					{
+						tmp = ptr->right;
+
+						delete_node(ptr);
+
+						++cnt;
+					}
+
+					ptr = tmp;
+				}
+
+				return cnt;
+			}
+
+			/*
+			 *	copies the tree rooted in the src node
+			 *
+			 *	a large tree (at least parallel_copy_threshold elements) with a stateless allocator is copied by two threads,
+			 *	the left subtree on a new thread and the right subtree on this thread
+			 */
+			node_pointer copy_tree(node_pointer src, size_type n)
+			{
+				if constexpr (std::allocator_traits<allocator_type>::is_always_equal::value)
 				{
-					clear(ptr->left);
-					clear(ptr->right);
+					if (parallel_copy_threshold <= n && src != nullptr)
+					{
+						auto left_copy { std::async(std::launch::async, [src]() {
+							allocator_type alloc {};
+
+							return node_type::copy_nodes(alloc, src->left);
+						}) };
+
+						node_pointer left  { nullptr };
+						node_pointer right { nullptr };
+
+						try
+						{
+							right = node_type::copy_nodes(get_allocator(), src->right);
+							left  = left_copy.get();
+						}
+						catch (...)
+						{
+							if (left_copy.valid())
+							{
+								try { clear(left_copy.get()); } catch (...) {}
+							}
+
+							clear(right);
 
-					node_type::delete_one_node(get_allocator(), ptr);
+							throw;
+						}
+
+						auto ptr { node_type::new_one_node(get_allocator(), left, right, nullptr, src->height, src->value) };
+
+						if (left != nullptr)
+							left->parent = ptr;
+
+						if (right != nullptr)
+							right->parent = ptr;
+
+						update_summary(ptr);
+
+						return ptr;
+					}
 				}
+
+				return node_type::copy_nodes(get_allocator(), src);
 			}
 
 			/*
@@ -710,11 +1383,12 @@ namespace cust					//customized / non-standard
 			template<class Ty>
 			std::pair<node_pointer, bool> find_location(const Ty& val) const
 			{
-				auto  ptr  { get_root() }, prev { ptr };
-				bool  flag { true };
-				auto& cmp  { get_compare() };
+				auto      ptr    { get_root() }, prev { ptr };
+				bool      flag   { true };
+				auto&     cmp    { get_compare() };
+				size_type length { 0 };
 
-				for ( ; flag && ptr != nullptr; )
+				for ( ; flag && ptr != nullptr; ++length)
 				{
 					prev = ptr;
 
@@ -726,9 +1400,48 @@ namespace cust					//customized / non-standard
 						flag = false;
 				}
 
+				get_stats().on_lookup(length);
+
 				return std::make_pair(flag ? prev : ptr, flag);
 			}
 
+			/*
+			 *	finds the location to insert a new element next to the hint node (pseudo head node for the end)
+			 *
+			 *	1. val is less than hint:    checks that the predecessor of hint is less than val
+			 *	2. val is greater than hint: checks that the successor   of hint is greater than val
+			 *	the new node is the left child of the greater one or the right child of the less one (the one without such child),
+			 *	falls back to the search from the root if the hint is wrong or nullptr
+			 */
+			template<class Ty>
+			std::pair<node_pointer, bool> find_location(node_pointer hint, const Ty& val) const
+			{
+				auto& cmp { get_compare() };
+
+				if (hint == nullptr || empty())
+					return find_location(val);
+
+				if (hint == impl.pseudo_head || cmp(val, hint->value))
+				{
+					auto prev { node_type::predecessor(hint) };
+
+					//the predecessor of the min node is the pseudo head node
+					if (prev == impl.pseudo_head || cmp(prev->value, val))
+						return std::make_pair(hint == impl.pseudo_head || hint->left != nullptr ? prev : hint, true);
+				}
+				else if (cmp(hint->value, val))
+				{
+					auto next { node_type::successor(hint) };
+
+					if (next == impl.pseudo_head || cmp(val, next->value))
+						return std::make_pair(hint->right != nullptr ? next : hint, true);
+				}
+				else
+					return std::make_pair(hint, false);
+
+				return find_location(val);
+			}
+
 			//gets the height of the ptr node
 			difference_type height(node_pointer ptr) const noexcept
 			{
@@ -749,11 +1462,15 @@ namespace cust					//customized / non-standard
 				return balance_factor < -1 ? rotate_to::right : (balance_factor > 1 ? rotate_to::left : rotate_to::nowhere);
 			}
 
-			//updates the height of the node pointed by ptr
+			//updates the height (and the summary) of the node pointed by ptr
 			void update_node_height(node_pointer ptr)
 			{
 				if (ptr != nullptr)
+				{
 					ptr->height = 1 + std::max(height(ptr->left), height(ptr->right));
+
+					node_type::update_summary(ptr);
+				}
 			}
 
 			/*
@@ -827,16 +1544,24 @@ namespace cust					//customized / non-standard
 			{
 				if (direction == rotate_to::left)
 				{
-					if (get_balance_factor(ptr->right) < 0)
+					bool twice { get_balance_factor(ptr->right) < 0 };
+
+					if (twice)
 						update_node_height(rotate_right(ptr->right));
 
+					get_stats().on_rotation(direction, twice);
+
 					return rotate_left(ptr);
 				}
 				else if (direction == rotate_to::right)
 				{
-					if (get_balance_factor(ptr->left) > 0)
+					bool twice { get_balance_factor(ptr->left) > 0 };
+
+					if (twice)
 						update_node_height(rotate_left(ptr->left));
 
+					get_stats().on_rotation(direction, twice);
+
 					return rotate_right(ptr);
 				}
 				else			// rotate_to::nowhere
@@ -845,6 +1570,335 @@ namespace cust					//customized / non-standard
 				}
 			}
 
+			/*
+			 *	split and join of detached subtrees (the parent pointers of their root nodes are not used)
+			 */
+
+			//attaches the subtrees l and r to the node pointed by ptr, updates its height (and summary)
+			node_pointer link(node_pointer l, node_pointer ptr, node_pointer r)
+			{
+				ptr->left  = l;
+				ptr->right = r;
+
+				if (l != nullptr)
+					l->parent = ptr;
+
+				if (r != nullptr)
+					r->parent = ptr;
+
+				update_node_height(ptr);
+
+				return ptr;
+			}
+
+			//performs a left rotation of a detached subtree, returns the new root
+			node_pointer rotate_left_subtree(node_pointer ptr)
+			{
+				auto child { ptr->right };
+				auto right { child->right };
+
+				get_stats().on_rotation(rotate_to::left, false);
+
+				return link(link(ptr->left, ptr, child->left), child, right);
+			}
+
+			//performs a right rotation of a detached subtree, returns the new root
+			node_pointer rotate_right_subtree(node_pointer ptr)
+			{
+				auto child { ptr->left };
+				auto left  { child->left };
+
+				get_stats().on_rotation(rotate_to::right, false);
+
+				return link(left, child, link(child->right, ptr, ptr->right));
+			}
+
+			/*
+			 *	joins the subtrees l and r with the node pointed by ptr in the middle (l < ptr < r), returns the new root
+			 *
+			 *	walks down the spine of the higher subtree until the heights are close, links there and rebalances on the way back
+			 *	O(|height(l) - height(r)| + 1)
+			 */
+			node_pointer join(node_pointer l, node_pointer ptr, node_pointer r)
+			{
+				if (height(r) + 1 < height(l))
+					return join_right(l, ptr, r);
+
+				if (height(l) + 1 < height(r))
+					return join_left(l, ptr, r);
+
+				return link(l, ptr, r);
+			}
+
+			//joins when the left subtree is higher, walks down its right spine
+			node_pointer join_right(node_pointer l, node_pointer ptr, node_pointer r)
+			{
+				auto ll { l->left };
+				auto lr { l->right };
+
+				if (height(lr) <= height(r) + 1)
+				{
+					auto tmp { link(lr, ptr, r) };
+
+					return height(tmp) <= height(ll) + 1 ? link(ll, l, tmp) : rotate_left_subtree(link(ll, l, rotate_right_subtree(tmp)));
+				}
+
+				auto tmp { join_right(lr, ptr, r) };
+
+				l = link(ll, l, tmp);
+
+				return height(tmp) <= height(ll) + 1 ? l : rotate_left_subtree(l);
+			}
+
+			//joins when the right subtree is higher, walks down its left spine
+			node_pointer join_left(node_pointer l, node_pointer ptr, node_pointer r)
+			{
+				auto rl { r->left };
+				auto rr { r->right };
+
+				if (height(rl) <= height(l) + 1)
+				{
+					auto tmp { link(l, ptr, rl) };
+
+					return height(tmp) <= height(rr) + 1 ? link(tmp, r, rr) : rotate_right_subtree(link(rotate_left_subtree(tmp), r, rr));
+				}
+
+				auto tmp { join_left(l, ptr, rl) };
+
+				r = link(tmp, r, rr);
+
+				return height(tmp) <= height(rr) + 1 ? r : rotate_right_subtree(r);
+			}
+
+			//joins the subtrees l and r (l < r) without a middle node
+			node_pointer join(node_pointer l, node_pointer r)
+			{
+				if (l == nullptr)
+					return r;
+
+				auto [rest, last] = split_last(l);
+
+				return join(rest, last, r);
+			}
+
+			/*
+			 *	splits the tree at the node pointed by pos in O(log n), bottom-up by the parent pointers from pos to the root
+			 *	(the root of the subtree holding pos must be the child of the pseudo head node)
+			 *
+			 *	return value: (the subtree before pos, pos, the subtree after pos)
+			 */
+			std::tuple<node_pointer, node_pointer, node_pointer> split_at(node_pointer pos)
+			{
+				auto l { pos->left };
+				auto r { pos->right };
+
+				for (auto child { pos }, ptr { pos->parent }; ptr != impl.pseudo_head; )
+				{
+					auto parent { ptr->parent };
+
+					if (ptr->left == child)
+						r = join(r, ptr, ptr->right);
+					else
+						l = join(ptr->left, ptr, l);
+
+					child = ptr;
+					ptr   = parent;
+				}
+
+				return { l, pos, r };
+			}
+
+			//gets the number of elements less than val (not greater than val if inclusive), O(log n) with the subtree_size augmentation
+			template<class Ty>
+			size_type rank(const Ty& val, bool inclusive) const
+			{
+				size_type cnt { 0 };
+				auto&     cmp { get_compare() };
+
+				for (auto ptr { get_root() }; ptr != nullptr; )
+				{
+					if (inclusive ? !cmp(val, ptr->value) : cmp(ptr->value, val))
+					{
+						cnt += node_type::get_summary(ptr->left) + 1;
+						ptr  = ptr->right;
+					}
+					else
+						ptr = ptr->left;
+				}
+
+				return cnt;
+			}
+
+			//builds a balanced subtree of n elements produced by gen() in order, the left half first
+			template<class Gen>
+			node_pointer build_sorted(size_type n, Gen& gen)
+			{
+				node_pointer ptr { nullptr };
+				node_pointer r   { nullptr };
+
+				if (n == 0)
+					return nullptr;
+
+				auto l { build_sorted(n / 2, gen) };
+
+				try
+				{
+					ptr       = new_node(gen());
+					ptr->left = l;
+					r         = build_sorted(n - n / 2 - 1, gen);
+				}
+				catch (...)
+				{
+					clear(ptr != nullptr ? ptr : l);
+
+					throw;
+				}
+
+				return link(l, ptr, r);
+			}
+
+			//splits the max node from the subtree rooted in the ptr node, returns (the rest of the subtree, the max node)
+			std::pair<node_pointer, node_pointer> split_last(node_pointer ptr)
+			{
+				if (ptr->right == nullptr)
+					return { ptr->left, ptr };
+
+				auto [rest, last] = split_last(ptr->right);
+
+				return { join(ptr->left, ptr, rest), last };
+			}
+
+			/*
+			 *	splits the subtree rooted in the ptr node by val in O(log n)
+			 *
+			 *	return value: (the subtree less than val, the node equivalent to val or nullptr, the subtree greater than val)
+			 */
+			template<class Ty>
+			std::tuple<node_pointer, node_pointer, node_pointer> split(node_pointer ptr, const Ty& val)
+			{
+				auto& cmp { get_compare() };
+
+				if (ptr == nullptr)
+					return { nullptr, nullptr, nullptr };
+
+				auto l { ptr->left };
+				auto r { ptr->right };
+
+				if (cmp(val, ptr->value))
+				{
+					auto [ll, mid, lr] = split(l, val);
+
+					return { ll, mid, join(lr, ptr, r) };
+				}
+
+				if (cmp(ptr->value, val))
+				{
+					auto [rl, mid, rr] = split(r, val);
+
+					return { join(l, ptr, rl), mid, rr };
+				}
+
+				return { l, ptr, r };
+			}
+
+			/*
+			 *	set operation of the subtrees rooted in the a node and the b node (both are consumed)
+			 *
+			 *	splits b by the root of a, processes the left parts and the right parts (on two threads if forks > 0),
+			 *	then joins the results with or without the root of a
+			 *
+			 *	return value: (the root of the result, the number of elements deleted)
+			 */
+			std::pair<node_pointer, size_type> set_operation_of(node_pointer a, node_pointer b, set_operation op, int forks)
+			{
+				if (a == nullptr || b == nullptr)
+				{
+					switch (op)
+					{
+						case set_operation::intersection:
+							return { nullptr, clear(a) + clear(b) };
+
+						case set_operation::difference:
+							return { a, clear(b) };
+
+						default:
+							return { a != nullptr ? a : b, 0 };
+					}
+				}
+
+				auto [l, dup, r] = split(b, a->value);
+				auto al { a->left };
+				auto ar { a->right };
+
+				std::pair<node_pointer, size_type> lres {};
+				std::pair<node_pointer, size_type> rres {};
+
+				if (0 < forks && parallel_subtree_height <= height(a))
+				{
+					auto left_result { std::async(std::launch::async, [this, al, l = l, op, forks]() {
+						return set_operation_of(al, l, op, forks - 1);
+					}) };
+
+					rres = set_operation_of(ar, r, op, forks - 1);
+					lres = left_result.get();
+				}
+				else
+				{
+					lres = set_operation_of(al, l, op, 0);
+					rres = set_operation_of(ar, r, op, 0);
+				}
+
+				auto cnt  { lres.second + rres.second };
+				bool keep { op == set_operation::union_of || (op == set_operation::intersection) == (dup != nullptr) };
+
+				if (dup != nullptr)
+				{
+					delete_node(dup);
+
+					++cnt;
+				}
+
+				if (keep)
+					return { join(lres.first, a, rres.first), cnt };
+
+				delete_node(a);
+
+				return { join(lres.first, rres.first), cnt + 1 };
+			}
+
+			//performs a set operation with the elements of other, other becomes empty
+			void set_operation_with(AVL_tree& other, set_operation op)
+			{
+				auto total { size() + other.size() };
+				auto forks { 0 };
+
+				if (this == &other)
+					return;
+
+				//the statistics are not updated by several threads
+				if constexpr (std::allocator_traits<allocator_type>::is_always_equal::value && std::is_same_v<Stats, no_stats>)
+				{
+					if (parallel_copy_threshold <= total)
+						for (auto n { std::thread::hardware_concurrency() }; 1u < n; n = (n + 1) / 2)
+							++forks;
+				}
+
+				auto [root, cnt] = set_operation_of(get_root(), other.get_root(), op, forks);
+
+				//the nodes of other are taken over by this tree
+				get_stats().on_allocate(other.size());
+				other.get_stats().on_deallocate(other.size());
+
+				other.impl.pseudo_head->left = nullptr;
+				other.impl.sz                = 0;
+
+				impl.pseudo_head->left = root;
+				impl.sz                = total - cnt;
+
+				if (root != nullptr)
+					root->parent = impl.pseudo_head;
+			}
+
 			//recursive version of preorder traversal
 			template<class Fn>
 			void preorder(node_pointer ptr, Fn func) const
@@ -893,24 +1947,24 @@ namespace cust					//customized / non-standard
 			}
 
 			//gets the compare function object
-			Compare& get_compare() noexcept
+			compare_type& get_compare() noexcept
 			{
 				return impl;
 			}
 
-			const Compare& get_compare() const noexcept
+			const compare_type& get_compare() const noexcept
 			{
 				return impl;
 			}
 
-			//gets the pointer pointing to the root node
-			node_pointer get_root() const noexcept
+			//gets the statistics
+			const Stats& get_stats() const noexcept
 			{
-				return impl.pseudo_head->left;
+				return impl;
 			}
 
 			//implementation type
-			struct impl_type : public Compare, allocator_type
+			struct impl_type : public compare_type, allocator_type
 			{
 				node_pointer pseudo_head { nullptr };			//a pointer pointing to pseudo head node
 				size_type    sz          { 0 };				//the number of elements of the tree
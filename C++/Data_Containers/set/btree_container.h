@@ -0,0 +1,419 @@
+#pragma once
+
+/*
+ *	B-tree container, an alternative to the balanced binary search tree (BBST) container
+ *
+ *	elements are stored in contiguous arrays of the nodes (fewer allocations and cache misses per lookup),
+ *	but insert() and erase() invalidate iterators
+ */
+
+#include <algorithm>
+#include "btree.h"
+
+namespace cust					//customized / non-standard
+{
+	template<class KeyTy, class ValTy, class Compare = std::less<ValTy>, class Allocator = std::allocator<ValTy>, class Tree = btree<ValTy, Compare, Allocator>>
+	class btree_container
+	{
+		public:
+			using key_type        = KeyTy;
+			using value_type      = ValTy;
+			using size_type       = std::size_t;
+			using difference_type = std::ptrdiff_t;
+			using key_compare     = Compare;
+			using value_compare   = Compare;
+			using allocator_type  = Allocator;
+			using reference       = value_type&;
+			using const_reference = const value_type&;
+			using pointer         = value_type*;
+			using const_pointer   = const value_type*;
+
+			using iterator               = btree_iterator<std::conditional_t<std::is_same_v<key_type, value_type>, std::add_const_t<value_type>, value_type>, typename Tree::node_type>;
+			using const_iterator         = btree_iterator<const value_type, typename Tree::node_type>;
+			using reverse_iterator       = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		protected:
+			using impl_type = Tree;
+
+		public:
+			//default constructor
+			btree_container() = default;
+
+			//copy constructor
+			btree_container(const btree_container& other) : bt { other.bt }
+			{
+			}
+
+			//move constructor
+			btree_container(btree_container&& other) noexcept : bt { std::move(other.bt) }
+			{
+			}
+
+			//range constructor
+			template<class InputIter>
+			btree_container(InputIter first, InputIter last) : bt(first, last)
+			{
+			}
+
+			//constructor with initializer list
+			btree_container(std::initializer_list<value_type> init) : bt { init }
+			{
+			}
+
+			//destructor
+			~btree_container()
+			{
+			}
+
+			//copy assignment
+			btree_container& operator = (const btree_container& other)
+			{
+				bt = other.bt;
+
+				return *this;
+			}
+
+			//move assignment
+			btree_container& operator = (btree_container&& other) noexcept
+			{
+				bt = std::move(other.bt);
+
+				return *this;
+			}
+
+			//assignment with initializer list
+			btree_container& operator = (std::initializer_list<value_type> init)
+			{
+				bt = init;
+
+				return *this;
+			}
+
+			//returns the allocator associated with the container
+			allocator_type get_allocator() const noexcept
+			{
+				return allocator_type(bt.get_allocator());
+			}
+
+			//returns the function object that compares the keys
+			key_compare key_comp() const
+			{
+				return bt.get_compare();
+			}
+
+			//returns the function object that compares objects of value_type
+			value_compare value_comp() const
+			{
+				return bt.get_compare();
+			}
+
+			//checks if the container is empty
+			bool empty() const noexcept
+			{
+				return bt.empty();
+			}
+
+			//gets the number of elements of the container
+			size_type size() const noexcept
+			{
+				return bt.size();
+			}
+
+			//clears all elements of the container
+			void clear() noexcept
+			{
+				bt.clear();
+			}
+
+			//inserts an element into the container (with copy semantics)
+			std::pair<iterator, bool> insert(const value_type& value)
+			{
+				auto pr { bt.insert(value) };
+
+				return { pr.first , pr.second };
+			}
+
+			//inserts an element into the container (with move semantics)
+			std::pair<iterator, bool> insert(value_type&& value)
+			{
+				auto pr { bt.insert(std::move(value)) };
+
+				return { pr.first , pr.second };
+			}
+
+			//inserts an element into the container, the hint is not used (a B-tree search touches only O(log n) nodes)
+			iterator insert(const_iterator, const value_type& value)
+			{
+				return insert(value).first;
+			}
+
+			iterator insert(const_iterator, value_type&& value)
+			{
+				return insert(std::move(value)).first;
+			}
+
+			//inserts a range of elements [first, last) into the container
+			template<class InputIter>
+			void insert(InputIter first, InputIter last)
+			{
+				bt.insert(first, last);
+			}
+
+			//inserts the elements of the initializer list into the container
+			void insert(std::initializer_list<value_type> init)
+			{
+				bt.insert(init);
+			}
+
+			//inserts an element into the container with its value constructed in-place
+			template<class... Args>
+			std::pair<iterator, bool> emplace(Args&&... args)
+			{
+				auto pr { bt.emplace(std::forward<Args>(args)...) };
+
+				return { pr.first , pr.second };
+			}
+
+			//inserts an element into the container with its value constructed in-place, the hint is not used
+			template<class... Args>
+			iterator emplace_hint(const_iterator, Args&&... args)
+			{
+				return emplace(std::forward<Args>(args)...).first;
+			}
+
+			//removes specified elements from the container
+			iterator erase(const_iterator pos)
+			{
+				return pos == cend() ? end() : iterator(bt.erase(pos));
+			}
+
+			iterator erase(const_iterator first, const_iterator last)
+			{
+				return iterator(bt.erase(first, last));
+			}
+
+			size_type erase(const key_type& key)
+			{
+				return bt.erase(key);
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent, class = std::enable_if_t<!std::is_convertible_v<K&&, iterator> && !std::is_convertible_v<K&&, const_iterator>>>
+			size_type erase(K&& key)
+			{
+				return bt.erase(key);
+			}
+
+			//exchanges the contents of the container with those of other
+			void swap(btree_container& other) noexcept
+			{
+				bt.swap(other.bt);
+			}
+
+			//returns the number of elements with the same key
+			size_type count(const key_type& key) const
+			{
+				return bt.contains(key) ? 1 : 0;
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			size_type count(const K& key) const
+			{
+				return bt.contains(key) ? 1 : 0;
+			}
+
+			//finds the element with the same key
+			iterator find(const key_type& key)
+			{
+				return bt.find(key);
+			}
+
+			const_iterator find(const key_type& key) const
+			{
+				return bt.find(key);
+			}
+
+			//finds the element with the key equivalent to the function argument (without constructing a key_type object)
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			iterator find(const K& key)
+			{
+				return bt.find(key);
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			const_iterator find(const K& key) const
+			{
+				return bt.find(key);
+			}
+
+			//checks if there is an element with the same key
+			bool contains(const key_type& key) const
+			{
+				return bt.contains(key);
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			bool contains(const K& key) const
+			{
+				return bt.contains(key);
+			}
+
+			//finds the first element with its key that is not less than the function argument
+			iterator lower_bound(const key_type& key)
+			{
+				return bt.lower_bound(key);
+			}
+
+			const_iterator lower_bound(const key_type& key) const
+			{
+				return bt.lower_bound(key);
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			iterator lower_bound(const K& key)
+			{
+				return bt.lower_bound(key);
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			const_iterator lower_bound(const K& key) const
+			{
+				return bt.lower_bound(key);
+			}
+
+			//finds the first element with its key that is greater than the function argument
+			iterator upper_bound(const key_type& key)
+			{
+				return bt.upper_bound(key);
+			}
+
+			const_iterator upper_bound(const key_type& key) const
+			{
+				return bt.upper_bound(key);
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			iterator upper_bound(const K& key)
+			{
+				return bt.upper_bound(key);
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			const_iterator upper_bound(const K& key) const
+			{
+				return bt.upper_bound(key);
+			}
+
+			//returns the range of elements with the same key, [lower_bound, upper_bound)
+			std::pair<iterator, iterator> equal_range(const key_type& key)
+			{
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+			{
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			std::pair<iterator, iterator> equal_range(const K& key)
+			{
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template<class K, class C = Compare, class = typename C::is_transparent>
+			std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+			{
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			//returns an iterator to the beginning
+			iterator begin() noexcept
+			{
+				return bt.begin();
+			}
+
+			//returns a const iterator to the beginning
+			const_iterator begin() const noexcept
+			{
+				return bt.begin();
+			}
+
+			const_iterator cbegin() const noexcept
+			{
+				return begin();
+			}
+
+			//returns an iterator to the end
+			iterator end() noexcept
+			{
+				return bt.end();
+			}
+
+			//returns a const iterator to the end
+			const_iterator end() const noexcept
+			{
+				return bt.end();
+			}
+
+			const_iterator cend() const noexcept
+			{
+				return end();
+			}
+
+			//returns a reverse iterator to the beginning
+			reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+			//returns a const reverse iterator to the beginning
+			const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+			const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+			//returns a reverse iterator to the end
+			reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+			//returns a const reverse iterator to the end
+			const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+			const_reverse_iterator crend() const noexcept { return rend(); }
+
+		protected:
+			impl_type bt {};
+	};
+
+	template<class KeyTy, class ValTy, class Compare, class Allocator, class Tree>
+	bool operator == (const btree_container<KeyTy, ValTy, Compare, Allocator, Tree>& lhs, const btree_container<KeyTy, ValTy, Compare, Allocator, Tree>& rhs)
+	{
+		return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+
+	template<class KeyTy, class ValTy, class Compare, class Allocator, class Tree>
+	bool operator != (const btree_container<KeyTy, ValTy, Compare, Allocator, Tree>& lhs, const btree_container<KeyTy, ValTy, Compare, Allocator, Tree>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template<class KeyTy, class ValTy, class Compare, class Allocator, class Tree>
+	bool operator < (const btree_container<KeyTy, ValTy, Compare, Allocator, Tree>& lhs, const btree_container<KeyTy, ValTy, Compare, Allocator, Tree>& rhs)
+	{
+		return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	template<class KeyTy, class ValTy, class Compare, class Allocator, class Tree>
+	bool operator <= (const btree_container<KeyTy, ValTy, Compare, Allocator, Tree>& lhs, const btree_container<KeyTy, ValTy, Compare, Allocator, Tree>& rhs)
+	{
+		return !(rhs < lhs);
+	}
+
+	template<class KeyTy, class ValTy, class Compare, class Allocator, class Tree>
+	bool operator > (const btree_container<KeyTy, ValTy, Compare, Allocator, Tree>& lhs, const btree_container<KeyTy, ValTy, Compare, Allocator, Tree>& rhs)
+	{
+		return rhs < lhs;
+	}
+
+	template<class KeyTy, class ValTy, class Compare, class Allocator, class Tree>
+	bool operator >= (const btree_container<KeyTy, ValTy, Compare, Allocator, Tree>& lhs, const btree_container<KeyTy, ValTy, Compare, Allocator, Tree>& rhs)
+	{
+		return !(lhs < rhs);
+	}
+}
@@ -1,15 +1,76 @@
 #pragma once
 
 #include "bbst_container.h"
+#include "btree_container.h"
 
 namespace cust					//customized / non-standard
 {
+	/*
+	 *	Container: the implementation of the set data container
+	 *	           bbst_container  (AVL tree, by default)
+	 *	           btree_container (B-tree)
+	 */
+	template<class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key>, template<class...> class Container = bbst_container>
+	class set : public Container<Key, Key, Compare, Allocator>
+	{
+		public:
+			using base_type = Container<Key, Key, Compare, Allocator>;
+
+			using base_type::base_type;
+	};
+
+	/*
+	 *	multiset data container, the equivalent elements keep the order of insertion
+	 *	(AVL tree with the size of each subtree, count() and equal_range() are O(log n))
+	 */
 	template<class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key>>
-	class set : public bbst_container<Key, Key, Compare, Allocator>
+	class multiset : public bbst_multicontainer<Key, Key, Compare, Allocator>
 	{
 		public:
-			using base_type = bbst_container<Key, Key, Compare, Allocator>;
+			using base_type = bbst_multicontainer<Key, Key, Compare, Allocator>;
 
 			using base_type::base_type;
 	};
+
+	/*
+	 *	set operations of two sets (AVL tree) by split and join, O(m log(n / m + 1)) for the sizes m <= n
+	 *
+	 *	the arguments are taken by value, pass them by std::move to reuse their nodes instead of copying them
+	 */
+
+	//the elements in lhs or rhs (the elements of lhs are kept for the equivalent keys)
+	template<class Key, class Compare, class Allocator>
+	set<Key, Compare, Allocator> set_union(set<Key, Compare, Allocator> lhs, set<Key, Compare, Allocator> rhs)
+	{
+		lhs.union_with(rhs);
+
+		return lhs;
+	}
+
+	//the elements in both lhs and rhs
+	template<class Key, class Compare, class Allocator>
+	set<Key, Compare, Allocator> set_intersection(set<Key, Compare, Allocator> lhs, set<Key, Compare, Allocator> rhs)
+	{
+		lhs.intersection_with(rhs);
+
+		return lhs;
+	}
+
+	//the elements in lhs but not in rhs
+	template<class Key, class Compare, class Allocator>
+	set<Key, Compare, Allocator> set_difference(set<Key, Compare, Allocator> lhs, set<Key, Compare, Allocator> rhs)
+	{
+		lhs.difference_with(rhs);
+
+		return lhs;
+	}
+
+	//the elements in either lhs or rhs but not in both
+	template<class Key, class Compare, class Allocator>
+	set<Key, Compare, Allocator> set_symmetric_difference(set<Key, Compare, Allocator> lhs, set<Key, Compare, Allocator> rhs)
+	{
+		lhs.symmetric_difference_with(rhs);
+
+		return lhs;
+	}
 }
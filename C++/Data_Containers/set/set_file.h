@@ -0,0 +1,148 @@
+#pragma once
+
+/*
+ *	binary serialization of set and a read-only set served from a mapped file (trivially copyable keys)
+ *
+ *	save() writes the keys in order, load() rebuilds a balanced tree in O(n) (no insertion) with any bbst_container,
+ *	other backends (btree_container) are filled by an insertion at the end of each element,
+ *	mapped_set opens the same file by mmap in O(1) and serves find() / lower_bound() by binary search on the mapped keys
+ */
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include "set.h"
+#include "sorted_file.h"
+
+namespace cust					//customized / non-standard
+{
+	//writes the elements of the set to the binary stream, throws std::runtime_error if the stream fails
+	template<class Key, class Compare, class Allocator, template<class...> class Container>
+	void save(std::ostream& os, const set<Key, Compare, Allocator, Container>& st)
+	{
+		sorted_file_header header {};
+
+		header.key_size = sizeof(Key);
+		header.count    = st.size();
+
+		write_header(os, header);
+
+		for (const auto& key : st)
+			write_raw(os, key);
+
+		if ( !os )
+			throw std::runtime_error("failed to write the set");
+	}
+
+	/*
+	 *	replaces the elements of the set with those read from the binary stream in O(n)
+	 *
+	 *	the keys are checked to be strictly ascending, throws std::runtime_error for an invalid or truncated stream
+	 *	(the set is left empty then)
+	 */
+	template<class Key, class Compare, class Allocator, template<class...> class Container>
+	void load(std::istream& is, set<Key, Compare, Allocator, Container>& st)
+	{
+		auto               header { read_header(is, sizeof(Key), 0) };
+		Compare            cmp    {};
+		std::optional<Key> last   {};
+
+		assign_sorted(st, static_cast<std::size_t>(header.count), [&is, &cmp, &last]() {
+			auto key { read_raw<Key>(is) };
+
+			if ( !is )
+				throw std::runtime_error("invalid set file: truncated keys");
+
+			if (last.has_value() && !cmp(*last, key))
+				throw std::runtime_error("invalid set file: the keys are not strictly ascending");
+
+			return *(last = key);
+		});
+	}
+
+	/*
+	 *	read-only set served straight from a file written by save(), opened in O(1) by mmap
+	 *
+	 *	find() and lower_bound() are binary searches on the mapped keys
+	 *	(the order of the keys is not checked when opening, the file is trusted to be written by save())
+	 */
+	template<class Key, class Compare = std::less<Key>>
+	class mapped_set
+	{
+		static_assert(std::is_trivially_copyable_v<Key>, "mapped_set needs trivially copyable keys");
+
+		public:
+			using key_type    = Key;
+			using size_type   = std::size_t;
+			using key_compare = Compare;
+
+			//opens the file read-only, throws std::runtime_error if the file is not a set file of the type
+			explicit mapped_set(const char* path) : file { path }
+			{
+				sorted_file_header header {};
+
+				if (file.size() < sorted_file_header::alignment)
+					throw std::runtime_error("invalid set file: truncated header");
+
+				std::memcpy(&header, file.data(), sizeof(header));
+
+				header.validate(sizeof(Key), 0);
+
+				if ( !sorted_file_header::fits(header.count, sizeof(Key), sorted_file_header::alignment, file.size()) )
+					throw std::runtime_error("invalid set file: truncated elements");
+
+				count      = static_cast<size_type>(header.count);
+				key_column = reinterpret_cast<const key_type*>(file.data() + sorted_file_header::alignment);
+			}
+
+			//checks if the set is empty
+			bool empty() const noexcept
+			{
+				return count == 0;
+			}
+
+			//gets the number of elements of the set
+			size_type size() const noexcept
+			{
+				return count;
+			}
+
+			//gets the sorted keys
+			const key_type* keys() const noexcept
+			{
+				return key_column;
+			}
+
+			//gets the index of the first key not less than key (size() if there is no such key)
+			size_type lower_bound(const key_type& key) const
+			{
+				return static_cast<size_type>(std::lower_bound(key_column, key_column + count, key, cmp) - key_column);
+			}
+
+			//gets the index of the first key greater than key (size() if there is no such key)
+			size_type upper_bound(const key_type& key) const
+			{
+				return static_cast<size_type>(std::upper_bound(key_column, key_column + count, key, cmp) - key_column);
+			}
+
+			//finds the element with the same key, nullptr if there is no such element
+			const key_type* find(const key_type& key) const
+			{
+				auto i { lower_bound(key) };
+
+				return i == count || cmp(key, key_column[i]) ? nullptr : key_column + i;
+			}
+
+			//checks if there is an element with the same key
+			bool contains(const key_type& key) const
+			{
+				return find(key) != nullptr;
+			}
+
+		private:
+			mapped_file     file;
+			const key_type* key_column { nullptr };
+			size_type       count      { 0 };
+			key_compare     cmp        {};
+	};
+}
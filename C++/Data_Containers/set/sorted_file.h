@@ -0,0 +1,275 @@
+#pragma once
+
+/*
+ *	binary file of the sorted elements of a map or a set (trivially copyable keys and mapped values)
+ *
+ *	layout:
+ *			header (64 bytes)
+ *			keys   (count * sizeof(Key)),     starting at byte 64
+ *			mapped (count * sizeof(T)),       starting at the next multiple of 64 (no mapped values for a set)
+ *
+ *	the elements are stored in the byte order and the layout of the machine, a file is read back on the same platform,
+ *	the shape of the tree is not stored, a balanced tree is rebuilt from the count in O(n)
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <bit>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cust					//customized / non-standard
+{
+	struct sorted_file_header
+	{
+		static constexpr std::size_t alignment { 64 };		//the size of the header and the alignment of the columns
+
+		//gets the offset of the mapped values after count keys of key_size bytes
+		static constexpr std::uint64_t mapped_offset(std::uint64_t count, std::uint64_t key_size) noexcept
+		{
+			return (alignment + count * key_size + alignment - 1) / alignment * alignment;
+		}
+
+		//checks if count elements of elem_size bytes fit between the offset and the end of a file of file_size bytes (no overflow)
+		static constexpr bool fits(std::uint64_t count, std::uint64_t elem_size, std::uint64_t offset, std::uint64_t file_size) noexcept
+		{
+			return offset <= file_size && count <= (file_size - offset) / elem_size;
+		}
+
+		//checks the header read from a file, throws std::runtime_error if the file is not for the element types
+		void validate(std::size_t key, std::size_t mapped) const
+		{
+			if (std::memcmp(magic, sorted_file_header {}.magic, sizeof(magic)) != 0 || version != 1)
+				throw std::runtime_error("invalid sorted file: bad magic number or version");
+
+			if (key_size != key || mapped_size != mapped)
+				throw std::runtime_error("invalid sorted file: the sizes of the elements do not match");
+		}
+
+		char          magic[8]    { 'c', 'u', 's', 't', 's', 'o', 'r', 't' };
+		std::uint32_t version     { 1 };
+		std::uint32_t key_size    { 0 };
+		std::uint32_t mapped_size { 0 };		//0 for a set
+		std::uint32_t reserved    { 0 };
+		std::uint64_t count       { 0 };
+	};
+
+	static_assert(sizeof(sorted_file_header) <= sorted_file_header::alignment);
+
+	//writes the bytes of a trivially copyable object
+	template<class T>
+	void write_raw(std::ostream& os, const T& obj)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "the type of the object is not trivially copyable");
+
+		os.write(reinterpret_cast<const char*>(std::addressof(obj)), sizeof(T));
+	}
+
+	//reads the bytes of a trivially copyable object
+	template<class T>
+	T read_raw(std::istream& is)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "the type of the object is not trivially copyable");
+
+		std::array<char, sizeof(T)> bytes {};
+
+		is.read(bytes.data(), sizeof(T));
+
+		return std::bit_cast<T>(bytes);
+	}
+
+	//writes zero bytes from the offset pos up to the next multiple of the alignment
+	inline void write_padding(std::ostream& os, std::uint64_t pos)
+	{
+		for ( ; pos % sorted_file_header::alignment != 0; ++pos)
+			os.put('\0');
+	}
+
+	//skips the bytes from the offset pos up to the next multiple of the alignment
+	inline void skip_padding(std::istream& is, std::uint64_t pos)
+	{
+		is.ignore(static_cast<std::streamsize>((sorted_file_header::alignment - pos % sorted_file_header::alignment) % sorted_file_header::alignment));
+	}
+
+	//writes the header padded to 64 bytes
+	inline void write_header(std::ostream& os, const sorted_file_header& header)
+	{
+		write_raw(os, header);
+		write_padding(os, sizeof(header));
+	}
+
+	//reads the header padded to 64 bytes and checks it
+	inline sorted_file_header read_header(std::istream& is, std::size_t key_size, std::size_t mapped_size)
+	{
+		auto header { read_raw<sorted_file_header>(is) };
+
+		skip_padding(is, sizeof(header));
+
+		if ( !is )
+			throw std::runtime_error("invalid sorted file: truncated header");
+
+		header.validate(key_size, mapped_size);
+
+		return header;
+	}
+
+	/*
+	 *	replaces the elements of the container with n elements made by gen in ascending order,
+	 *	in O(n) by assign_sorted() where the backend provides it (bbst_container), else by an insertion at the end of each one
+	 *
+	 *	the container is left empty if gen throws
+	 */
+	template<class Container, class Gen>
+	void assign_sorted(Container& cont, std::size_t n, Gen gen)
+	{
+		if constexpr (requires { cont.assign_sorted(n, gen); })
+			cont.assign_sorted(n, gen);
+		else
+		{
+			cont.clear();
+
+			try
+			{
+				for (std::size_t i { 0 }; i != n; ++i)
+					cont.insert(cont.end(), gen());
+			}
+			catch (...)
+			{
+				cont.clear();
+
+				throw;
+			}
+		}
+	}
+
+	/*
+	 *	a file mapped into memory read-only (mmap / MapViewOfFile), the pages are loaded on demand by the OS
+	 *
+	 *	throws std::runtime_error if the file cannot be opened or mapped
+	 */
+	class mapped_file
+	{
+		public:
+			explicit mapped_file(const char* path)
+			{
+#if defined(_WIN32)
+				auto file { CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+
+				if (file == INVALID_HANDLE_VALUE)
+					throw std::runtime_error("failed to open the file");
+
+				LARGE_INTEGER file_size {};
+
+				if ( !GetFileSizeEx(file, &file_size) )
+				{
+					CloseHandle(file);
+
+					throw std::runtime_error("failed to get the size of the file");
+				}
+
+				sz = static_cast<std::size_t>(file_size.QuadPart);
+
+				if (sz != 0)
+				{
+					auto mapping { CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+
+					addr = mapping == nullptr ? nullptr : MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+					if (mapping != nullptr)
+						CloseHandle(mapping);
+				}
+
+				CloseHandle(file);
+
+				if (sz != 0 && addr == nullptr)
+					throw std::runtime_error("failed to map the file");
+#else
+				auto fd { ::open(path, O_RDONLY) };
+
+				if (fd < 0)
+					throw std::runtime_error("failed to open the file");
+
+				struct stat st {};
+
+				if (::fstat(fd, &st) != 0)
+				{
+					::close(fd);
+
+					throw std::runtime_error("failed to get the size of the file");
+				}
+
+				sz = static_cast<std::size_t>(st.st_size);
+
+				if (sz != 0)
+				{
+					addr = ::mmap(nullptr, sz, PROT_READ, MAP_SHARED, fd, 0);
+
+					if (addr == MAP_FAILED)
+						addr = nullptr;
+				}
+
+				::close(fd);
+
+				if (sz != 0 && addr == nullptr)
+					throw std::runtime_error("failed to map the file");
+#endif
+			}
+
+			mapped_file(const mapped_file&) = delete;
+			mapped_file& operator = (const mapped_file&) = delete;
+
+			mapped_file(mapped_file&& other) noexcept : addr { std::exchange(other.addr, nullptr) }, sz { std::exchange(other.sz, 0) }
+			{
+			}
+
+			mapped_file& operator = (mapped_file&& other) noexcept
+			{
+				std::swap(addr, other.addr);
+				std::swap(sz,   other.sz);
+
+				return *this;
+			}
+
+			~mapped_file()
+			{
+				if (addr != nullptr)
+				{
+#if defined(_WIN32)
+					UnmapViewOfFile(addr);
+#else
+					::munmap(addr, sz);
+#endif
+				}
+			}
+
+			//gets the first byte of the file
+			const std::byte* data() const noexcept
+			{
+				return static_cast<const std::byte*>(addr);
+			}
+
+			//gets the size of the file in bytes
+			std::size_t size() const noexcept
+			{
+				return sz;
+			}
+
+		private:
+			void*       addr { nullptr };		//the address of the mapped view
+			std::size_t sz   { 0 };			//the size of the file
+	};
+}
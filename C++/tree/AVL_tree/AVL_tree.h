@@ -68,26 +68,38 @@ namespace cust					//customized / non-standard
 			std::allocator_traits<Allocator>::deallocate(alloc, ptr, 1);
 		}
 
-		//copies the subtree rooted in the src node
+		//copies the subtree rooted in the src node (walks both trees side by side, the parent pointers lead the way back up)
 		template<class Allocator>
 		[[nodiscard]] static node_pointer copy_nodes(Allocator& alloc, const_node_pointer src)
 		{
-			node_pointer ptr { nullptr };
+			if (src == nullptr)
+				return nullptr;
 
-			if (src != nullptr)
-			{
-				ptr = new_one_node(alloc, copy_nodes(alloc, src->left), copy_nodes(alloc, src->right), nullptr, src->height, src->value);
+			auto root { new_one_node(alloc, nullptr, nullptr, nullptr, src->height, src->value) };
 
-				//has the left  child
-				if (ptr->left != nullptr)
-					ptr->left->parent = ptr;
+			for (auto ptr { root }; ; )
+			{
+				if (src->left != nullptr && ptr->left == nullptr)
+				{
+					src = src->left;
+					ptr = ptr->left  = new_one_node(alloc, nullptr, nullptr, ptr, src->height, src->value);
+				}
+				else if (src->right != nullptr && ptr->right == nullptr)
+				{
+					src = src->right;
+					ptr = ptr->right = new_one_node(alloc, nullptr, nullptr, ptr, src->height, src->value);
+				}
+				else
+				{
+					if (ptr == root)
+						break;
 
-				//has the right child
-				if (ptr->right != nullptr)
-					ptr->right->parent = ptr;
+					src = src->parent;
+					ptr = ptr->parent;
+				}
 			}
 
-			return ptr;
+			return root;
 		}
 
 		//finds the node with the max value of the subtree rooted in the parent node
@@ -314,6 +326,9 @@ namespace cust					//customized / non-standard
 				return erase(this->find(value));
 			}
 
+			//an AVL tree is always balanced (the rotations of the base would not update the heights of the nodes)
+			void rebalance() = delete;
+
 			//gets the allocator
 			allocator_type& get_allocator() noexcept
 			{
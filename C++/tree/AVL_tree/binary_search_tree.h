@@ -2,6 +2,10 @@
 
 #include <functional>
 #include <initializer_list>
+#include <bit>
+#include <cmath>
+#include <ratio>
+#include <type_traits>
 #include "binary_tree.h"
 
 namespace cust					//customized / non-standard
@@ -65,26 +69,38 @@ namespace cust					//customized / non-standard
 			std::allocator_traits<Allocator>::deallocate(alloc, ptr, 1);
 		}
 
-		//copies the subtree rooted in the src node
+		//copies the subtree rooted in the src node (walks both trees side by side, the parent pointers lead the way back up)
 		template<class Allocator>
 		[[nodiscard]] static node_pointer copy_nodes(Allocator& alloc, node_pointer src)
 		{
-			node_pointer ptr { nullptr };
+			if (src == nullptr)
+				return nullptr;
 
-			if (src != nullptr)
-			{
-				ptr = new_one_node(alloc, copy_nodes(alloc, src->left), copy_nodes(alloc, src->right), nullptr, src->value);
+			auto root { new_one_node(alloc, nullptr, nullptr, nullptr, src->value) };
 
-				//has the left  child
-				if (ptr->left != nullptr)
-					ptr->left->parent = ptr;
+			for (auto ptr { root }; ; )
+			{
+				if (src->left != nullptr && ptr->left == nullptr)
+				{
+					src = src->left;
+					ptr = ptr->left  = new_one_node(alloc, nullptr, nullptr, ptr, src->value);
+				}
+				else if (src->right != nullptr && ptr->right == nullptr)
+				{
+					src = src->right;
+					ptr = ptr->right = new_one_node(alloc, nullptr, nullptr, ptr, src->value);
+				}
+				else
+				{
+					if (ptr == root)
+						break;
 
-				//has the right child
-				if (ptr->right != nullptr)
-					ptr->right->parent = ptr;
+					src = src->parent;
+					ptr = ptr->parent;
+				}
 			}
 
-			return ptr;
+			return root;
 		}
 
 		node_pointer left   { nullptr };			//pointer pointing to left  child node
@@ -93,7 +109,29 @@ namespace cust					//customized / non-standard
 		value_type   value  {};				//data value
 	};
 
-	template<class T, class node_type = binary_search_tree_node<T>, class Compare = std::less<T>, class Allocator = std::allocator<node_type>>
+	//no automatic rebalancing, the depth depends on the order of the insertions (rebalance() balances the tree on demand)
+	struct no_rebalance
+	{
+	};
+
+	/*
+	 *	scapegoat rebalancing with the weight balance Alpha (1/2 < Alpha < 1)
+	 *
+	 *	an insertion deeper than log_{1/Alpha}(n) finds its lowest ancestor with a child heavier than Alpha of it (the scapegoat)
+	 *	and rebuilds the subtree of the scapegoat, a removal rebuilds the whole tree when it shrinks below Alpha of its max size
+	 *	since the last rebuild, so the depth stays O(log n) with O(log n) amortized insertions and removals
+	 */
+	template<class Alpha = std::ratio<2, 3>>
+	struct scapegoat_rebalance
+	{
+		static_assert(Alpha::den < 2 * Alpha::num && Alpha::num < Alpha::den, "Alpha of scapegoat_rebalance must be in (1/2, 1)");
+
+		using alpha = Alpha;
+
+		std::size_t max_size { 0 };		//the max number of elements since the last rebuild of the whole tree
+	};
+
+	template<class T, class node_type = binary_search_tree_node<T>, class Compare = std::less<T>, class Allocator = std::allocator<node_type>, class Rebalance = no_rebalance>
 	class binary_search_tree : public binary_tree<T, node_type, Allocator>
 	{
 		private:
@@ -109,14 +147,15 @@ namespace cust					//customized / non-standard
 			binary_search_tree() noexcept = default;
 
 			//copy constructor
-			binary_search_tree(const binary_search_tree& other) : base_type { other }, sz { other.sz }
+			binary_search_tree(const binary_search_tree& other) : base_type { other }, sz { other.sz }, balance { other.balance }
 			{
 			}
 
 			//move constructor
 			binary_search_tree(binary_search_tree&& other) noexcept : base_type { std::move(other) }
 			{
-				std::swap(sz, other.sz);
+				std::swap(sz,      other.sz);
+				std::swap(balance, other.balance);
 			}
 
 			//range constructor
@@ -147,7 +186,8 @@ namespace cust					//customized / non-standard
 
 				base_type::operator=(other);
 
-				sz = other.sz;
+				sz      = other.sz;
+				balance = other.balance;
 
 				return *this;
 			}
@@ -189,7 +229,8 @@ namespace cust					//customized / non-standard
 			{
 				base_type::clear();
 
-				sz = 0;
+				sz      = 0;
+				balance = Rebalance {};
 			}
 
 			//gets the pointer pointing to the node with the max value of the tree
@@ -214,6 +255,8 @@ namespace cust					//customized / non-standard
 					pr.first = (pr.first == nullptr ? this->add_root(value) : append_child(pr.first, value));
 
 					++sz;
+
+					inserted(pr.first);
 				}
 
 				return std::make_pair(pr.first, pr.second);
@@ -229,6 +272,8 @@ namespace cust					//customized / non-standard
 					pr.first = (pr.first == nullptr ? this->add_root(std::move(value)) : append_child(pr.first, std::move(value)));
 
 					++sz;
+
+					inserted(pr.first);
 				}
 
 				return std::make_pair(pr.first , pr.second);
@@ -274,6 +319,8 @@ namespace cust					//customized / non-standard
 					}
 
 					++sz;
+
+					inserted(pr.first);
 				}
 				else
 					node_type::delete_one_node(this->alloc, ptr);
@@ -284,7 +331,12 @@ namespace cust					//customized / non-standard
 			//removes the element at pos from the tree
 			node_pointer erase(node_pointer pos)
 			{
-				return erase_node(pos).first;
+				auto next { erase_node(pos).first };
+
+				if (pos != nullptr)
+					erased();
+
+				return next;
 			}
 
 			//removes the element with the equivalent value from the tree
@@ -298,6 +350,24 @@ namespace cust					//customized / non-standard
 			{
 				std::swap(this->root, other.root);
 				std::swap(sz,         other.sz);
+				std::swap(balance,    other.balance);
+			}
+
+			/*
+			 *	balances the tree in place by the Day-Stout-Warren algorithm, O(n) time and O(1) extra space
+			 *
+			 *	1. rotates right until the tree is a vine (every node has only a right child, in ascending order)
+			 *	2. rotates left every other node of the vine, down to the number of the nodes of the bottom level,
+			 *	   then repeatedly every other node of the remaining vine, each pass halves the vine into a complete tree
+			 *
+			 *	the height becomes floor(log2(n)), the pointers to the nodes stay valid
+			 */
+			void rebalance() noexcept
+			{
+				rebuild(this->root);
+
+				if constexpr ( !std::is_same_v<Rebalance, no_rebalance> )
+					balance.max_size = sz;
 			}
 
 			//finds the element with the equivalent value of the tree
@@ -360,6 +430,159 @@ namespace cust					//customized / non-standard
 			}
 
 		protected:
+			//gets the link (the child pointer of the parent or the root pointer) pointing to the node
+			node_pointer& link_of(node_pointer ptr) noexcept
+			{
+				return ptr->parent == nullptr ? this->root : (ptr->parent->left == ptr ? ptr->parent->left : ptr->parent->right);
+			}
+
+			//rotates the subtree pointed by the link to the left, its right child takes its place
+			static void rotate_link_left(node_pointer& link) noexcept
+			{
+				auto ptr   { link };
+				auto right { ptr->right };
+
+				ptr->right = right->left;
+
+				if (right->left != nullptr)
+					right->left->parent = ptr;
+
+				right->left   = ptr;
+				right->parent = ptr->parent;
+				ptr->parent   = right;
+				link          = right;
+			}
+
+			//rotates the subtree pointed by the link to the right, its left child takes its place
+			static void rotate_link_right(node_pointer& link) noexcept
+			{
+				auto ptr  { link };
+				auto left { ptr->left };
+
+				ptr->left = left->right;
+
+				if (left->right != nullptr)
+					left->right->parent = ptr;
+
+				left->right  = ptr;
+				left->parent = ptr->parent;
+				ptr->parent  = left;
+				link         = left;
+			}
+
+			//rotates left count nodes of the vine pointed by the link, every other one from the top
+			static void compress(node_pointer& link, size_type count) noexcept
+			{
+				auto ptr { &link };
+
+				for ( ; count != 0; --count)
+				{
+					rotate_link_left(*ptr);
+
+					ptr = &(*ptr)->right;
+				}
+			}
+
+			//balances the subtree pointed by the link by the Day-Stout-Warren algorithm (see rebalance())
+			static void rebuild(node_pointer& link) noexcept
+			{
+				size_type n { 0 };
+
+				//tree to vine
+				for (auto ptr { &link }; *ptr != nullptr; )
+				{
+					if ((*ptr)->left != nullptr)
+						rotate_link_right(*ptr);
+					else
+					{
+						++n;
+
+						ptr = &(*ptr)->right;
+					}
+				}
+
+				//vine to tree, the nodes of the bottom level first, then a perfect tree of m nodes
+				auto m { std::bit_floor(n + 1) - 1 };
+
+				compress(link, n - m);
+
+				for ( ; 1 < m; m /= 2)
+					compress(link, m / 2);
+			}
+
+			//gets the number of nodes of the subtree rooted in the root node, by a walk with the parent pointers (O(1) space)
+			static size_type count(node_pointer root) noexcept
+			{
+				size_type n { 0 };
+
+				for (auto ptr { root }, prev { root == nullptr ? nullptr : root->parent }; ptr != nullptr && ptr != root->parent; )
+				{
+					auto next { ptr->parent };
+
+					if (prev == ptr->parent)
+					{
+						++n;
+
+						next = ptr->left != nullptr ? ptr->left : (ptr->right != nullptr ? ptr->right : ptr->parent);
+					}
+					else if (prev == ptr->left && ptr->right != nullptr)
+						next = ptr->right;
+
+					prev = ptr;
+					ptr  = next;
+				}
+
+				return n;
+			}
+
+			//rebuilds the subtree of the scapegoat if the new node pointed by ptr is too deep (scapegoat_rebalance)
+			void inserted(node_pointer ptr) noexcept
+			{
+				if constexpr ( !std::is_same_v<Rebalance, no_rebalance> )
+				{
+					using alpha = typename Rebalance::alpha;
+
+					balance.max_size = std::max(balance.max_size, sz);
+
+					size_type depth { 0 };
+
+					for (auto p { ptr }; p->parent != nullptr; p = p->parent)
+						++depth;
+
+					if (depth <= std::log(static_cast<double>(sz)) / std::log(static_cast<double>(alpha::den) / alpha::num))
+						return;
+
+					//the sizes of the ancestors are counted upwards until a child is heavier than alpha of its parent
+					size_type n { 1 };
+
+					for (auto child { ptr }, parent { ptr->parent }; parent != nullptr; child = parent, parent = parent->parent)
+					{
+						auto total { n + 1 + count(child == parent->left ? parent->right : parent->left) };
+
+						if (alpha::num * total < alpha::den * n)
+						{
+							rebuild(link_of(parent));
+
+							return;
+						}
+
+						n = total;
+					}
+				}
+			}
+
+			//rebuilds the whole tree if it has shrunk below alpha of its max size (scapegoat_rebalance)
+			void erased() noexcept
+			{
+				if constexpr ( !std::is_same_v<Rebalance, no_rebalance> )
+				{
+					using alpha = typename Rebalance::alpha;
+
+					if (alpha::den * sz < alpha::num * balance.max_size)
+						rebalance();
+				}
+			}
+
 			//appends a child node to the parent node (with copy semantics)
 			node_pointer append_child(node_pointer parent, const value_type& value)
 			{
@@ -542,5 +765,7 @@ namespace cust					//customized / non-standard
 
 			size_type sz  { 0 };		//the number of elements / nodes of the tree
 			Compare   cmp {};			//element comparison function
+
+			[[no_unique_address]] Rebalance balance {};		//automatic rebalancing policy and its state
 	};
 }
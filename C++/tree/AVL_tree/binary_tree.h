@@ -69,11 +69,33 @@ namespace cust					//customized / non-standard
 			std::allocator_traits<Allocator>::deallocate(alloc, ptr, 1);
 		}
 
-		//copies the subtree rooted in the src node
+		//copies the subtree rooted in the src node (preorder with an explicit stack of the source nodes and the links to fill in)
 		template<class Allocator>
 		[[nodiscard]] static node_pointer copy_nodes(Allocator& alloc, node_pointer src)
 		{
-			return src == nullptr ? nullptr : new_one_node(alloc, copy_nodes(alloc, src->left), copy_nodes(alloc, src->right), src->value);
+			std::stack<std::pair<node_pointer, node_pointer*>> stk {};
+			node_pointer root { nullptr };
+
+			if (src != nullptr)
+				stk.emplace(src, &root);
+
+			for ( ; !stk.empty(); )
+			{
+				auto [ptr, link] = stk.top();
+
+				stk.pop();
+
+				*link = new_node(alloc, ptr->value);
+
+				//stack is FILO, push the right child node first
+				if (ptr->right != nullptr)
+					stk.emplace(ptr->right, &(*link)->right);
+
+				if (ptr->left != nullptr)
+					stk.emplace(ptr->left,  &(*link)->left);
+			}
+
+			return root;
 		}
 
 		node_pointer left  { nullptr };			//pointer pointing to left  child node
@@ -290,15 +312,30 @@ namespace cust					//customized / non-standard
 				return ptr == nullptr ? -1 : 1 + std::max(height(ptr->left), height(ptr->right));
 			}
 
-			//clears all elements of the subtree rooted in the ptr node
+			/*
+			 *	clears all elements of the subtree rooted in the ptr node
+			 *
+			 *	rotates the left child up until the node has no left child, then deletes the node and goes on with its right child
+			 *	(no recursion and no extra space, even for a degenerate tree)
+			 */
 			void clear(node_pointer ptr) noexcept
 			{
-				if (ptr != nullptr)
+				for (node_pointer tmp { nullptr }; ptr != nullptr; )
 				{
-					clear(ptr->left);
-					clear(ptr->right);
-
-					node_type::delete_one_node(alloc, ptr);
+					if (ptr->left != nullptr)
+					{
+						tmp        = ptr->left;
+						ptr->left  = tmp->right;
+						tmp->right = ptr;
+					}
+					else
+					{
+						tmp = ptr->right;
+
+						node_type::delete_one_node(alloc, ptr);
+					}
+
+					ptr = tmp;
 				}
 			}
 
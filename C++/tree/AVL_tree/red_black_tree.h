@@ -0,0 +1,557 @@
+#pragma once
+
+#include "binary_search_tree.h"
+
+namespace cust					//customized / non-standard
+{
+	//red-black tree node
+	template<class T>
+	struct red_black_tree_node
+	{
+		using value_type         = T;
+		using node_pointer       = red_black_tree_node*;
+		using const_node_pointer = const red_black_tree_node*;
+
+		enum class color_type : char { red, black };
+
+		//adds a tree node by allocating memory space and calling its constructor (a new node is red)
+		template<class Allocator, class... Args>
+		[[nodiscard]] static node_pointer new_node(Allocator& alloc, Args&&... args)
+		{
+			auto ptr { std::allocator_traits<Allocator>::allocate(alloc, 1) };
+
+			ptr->parent = ptr->right = ptr->left = nullptr;
+			ptr->color  = color_type::red;
+			std::allocator_traits<Allocator>::construct(alloc, std::addressof(ptr->value), std::forward<Args>(args)...);
+
+			return ptr;
+		}
+
+		template<class Allocator, class... Args>
+		[[nodiscard]] static node_pointer new_one_node(Allocator& alloc, node_pointer l, node_pointer r, node_pointer p, color_type c, Args&&... args)
+		{
+			auto ptr { std::allocator_traits<Allocator>::allocate(alloc, 1) };
+
+			ptr->left   = l;
+			ptr->right  = r;
+			ptr->parent = p;
+			ptr->color  = c;
+			std::allocator_traits<Allocator>::construct(alloc, std::addressof(ptr->value), std::forward<Args>(args)...);
+
+			return ptr;
+		}
+
+		//appends a left child node to the node pointed by ptr
+		template<class Allocator, class... Args>
+		static node_pointer append_left(Allocator& alloc, node_pointer ptr, Args&&... args)
+		{
+			if (ptr != nullptr && ptr->left == nullptr)
+				ptr->left = new_one_node(alloc, nullptr, nullptr, ptr, color_type::red, std::forward<Args>(args)...);
+
+			return ptr == nullptr ? nullptr : ptr->left;
+		}
+
+		//appends a right child node to the node pointed by ptr
+		template<class Allocator, class... Args>
+		static node_pointer append_right(Allocator& alloc, node_pointer ptr, Args&&... args)
+		{
+			if (ptr != nullptr && ptr->right == nullptr)
+				ptr->right = new_one_node(alloc, nullptr, nullptr, ptr, color_type::red, std::forward<Args>(args)...);
+
+			return ptr == nullptr ? nullptr : ptr->right;
+		}
+
+		//deletes a tree node by calling its destructor and deallocating memory space
+		template<class Allocator>
+		static void delete_one_node(Allocator& alloc, node_pointer ptr) noexcept
+		{
+			std::allocator_traits<Allocator>::destroy(alloc, ptr);
+			std::allocator_traits<Allocator>::deallocate(alloc, ptr, 1);
+		}
+
+		//copies the subtree rooted in the src node (walks both trees side by side, the parent pointers lead the way back up)
+		template<class Allocator>
+		[[nodiscard]] static node_pointer copy_nodes(Allocator& alloc, const_node_pointer src)
+		{
+			if (src == nullptr)
+				return nullptr;
+
+			auto root { new_one_node(alloc, nullptr, nullptr, nullptr, src->color, src->value) };
+
+			for (auto ptr { root }; ; )
+			{
+				if (src->left != nullptr && ptr->left == nullptr)
+				{
+					src = src->left;
+					ptr = ptr->left  = new_one_node(alloc, nullptr, nullptr, ptr, src->color, src->value);
+				}
+				else if (src->right != nullptr && ptr->right == nullptr)
+				{
+					src = src->right;
+					ptr = ptr->right = new_one_node(alloc, nullptr, nullptr, ptr, src->color, src->value);
+				}
+				else
+				{
+					if (ptr == root)
+						break;
+
+					src = src->parent;
+					ptr = ptr->parent;
+				}
+			}
+
+			return root;
+		}
+
+		node_pointer left   { nullptr };				//pointer pointing to left  child node
+		node_pointer right  { nullptr };				//pointer pointing to right child node
+		node_pointer parent { nullptr };				//pointer pointing to parent      node
+		color_type   color  { color_type::red };			//color of the node
+		value_type   value  {};					//data value
+	};
+
+	/*
+	 *	red-black tree data structure
+	 *
+	 *	1. a node is red or black, the root is black
+	 *	2. a red node has no red child
+	 *	3. every path from a node down to a null link has the same number of black nodes
+	 *
+	 *	the height is at most 2 log2(n + 1), an insertion takes at most 2 rotations and a removal at most 3
+	 *	(an AVL tree is more strictly balanced but may rotate on every level of a removal)
+	 */
+	template<class T, class node_type = red_black_tree_node<T>, class Compare = std::less<T>, class Allocator = std::allocator<node_type>>
+	class red_black_tree : public binary_search_tree<T, node_type, Compare, Allocator>
+	{
+		private:
+			using base_type  = binary_search_tree<T, node_type, Compare, Allocator>;
+			using color_type = typename node_type::color_type;
+
+		public:
+			using value_type         = typename base_type::value_type;
+			using size_type          = typename base_type::size_type;
+			using difference_type    = typename base_type::difference_type;
+			using node_pointer       = typename base_type::node_pointer;
+			using const_node_pointer = typename base_type::const_node_pointer;
+			using allocator_type     = typename base_type::allocator_type;
+
+			//default constructor
+			red_black_tree() noexcept = default;
+
+			//copy constructor
+			red_black_tree(const red_black_tree& other)
+			{
+				this->root = node_type::copy_nodes(get_allocator(), other.get_root());
+				this->sz   = other.sz;
+			}
+
+			//move constructor
+			red_black_tree(red_black_tree&& other) noexcept
+			{
+				this->swap(other);
+			}
+
+			//range constructor
+			template<class InputIter>
+			red_black_tree(InputIter first, InputIter last)
+			{
+				for ( ; first != last; ++first)
+					insert(*first);
+			}
+
+			//constructor with initializer list
+			red_black_tree(std::initializer_list<value_type> init)
+			{
+				for (const auto& elem : init)
+					insert(elem);
+			}
+
+			//destructor
+			~red_black_tree()
+			{
+			}
+
+			//copy assignment
+			red_black_tree& operator = (const red_black_tree& other)
+			{
+				base_type::operator=(other);
+
+				return *this;
+			}
+
+			//move assignment
+			red_black_tree& operator = (red_black_tree&& other) noexcept
+			{
+				base_type::operator=(std::move(other));
+
+				return *this;
+			}
+
+			//assignment with initializer list
+			red_black_tree& operator = (std::initializer_list<value_type> init)
+			{
+				this->clear();
+
+				insert(init);
+
+				return *this;
+			}
+
+			//inserts an element into the tree (with copy semantics)
+			auto insert(const value_type& value)
+			{
+				auto pr { base_type::insert(value) };
+
+				if (pr.second)
+					fix_insertion(pr.first);
+
+				return pr;
+			}
+
+			//inserts an element into the tree (with move semantics)
+			auto insert(value_type&& value)
+			{
+				auto pr { base_type::insert(std::move(value)) };
+
+				if (pr.second)
+					fix_insertion(pr.first);
+
+				return pr;
+			}
+
+			//inserts a range of elements [first, last) into the tree
+			template<class InputIter>
+			void insert(InputIter first, InputIter last)
+			{
+				for ( ; first != last; ++first)
+					insert(*first);
+			}
+
+			//inserts the elements of the initializer list into the tree
+			void insert(std::initializer_list<value_type> init)
+			{
+				insert(init.begin(), init.end());
+			}
+
+			//inserts an element into the tree with its value constructed in-place
+			template<class... Args>
+			auto emplace(Args&&... args)
+			{
+				auto pr { base_type::emplace(std::forward<Args>(args)...) };
+
+				if (pr.second)
+					fix_insertion(pr.first);
+
+				return pr;
+			}
+
+			//removes the element at pos from the tree, returns its successor
+			node_pointer erase(node_pointer pos)
+			{
+				if (pos == nullptr)
+					return nullptr;
+
+				auto         next    { this->successor(pos) };
+				auto         removed { pos->color };		//the color removed from its position
+				node_pointer ptr     { nullptr };		//the node moved into the removed position (may be null)
+				node_pointer parent  { nullptr };		//the parent of that position
+
+				if (pos->left == nullptr || pos->right == nullptr)
+				{
+					ptr    = pos->left != nullptr ? pos->left : pos->right;
+					parent = pos->parent;
+
+					transplant(pos, ptr);
+				}
+				else
+				{
+					//the successor takes the place and the color of the node to erase
+					removed = next->color;
+					ptr     = next->right;
+					parent  = next->parent == pos ? next : next->parent;
+
+					if (next->parent != pos)
+					{
+						transplant(next, next->right);
+
+						next->right         = pos->right;
+						next->right->parent = next;
+					}
+
+					transplant(pos, next);
+
+					next->left         = pos->left;
+					next->left->parent = next;
+					next->color        = pos->color;
+				}
+
+				node_type::delete_one_node(this->alloc, pos);
+
+				--this->sz;
+
+				if (removed == color_type::black)
+					fix_removal(ptr, parent);
+
+				return next;
+			}
+
+			//removes the element with the equivalent value from the tree
+			node_pointer erase(const value_type& value)
+			{
+				return erase(this->find(value));
+			}
+
+			//a red-black tree is always balanced (the rotations of the base would not recolor the nodes)
+			void rebalance() = delete;
+
+			//gets the allocator
+			allocator_type& get_allocator() noexcept
+			{
+				return this->alloc;
+			}
+
+			const allocator_type& get_allocator() const noexcept
+			{
+				return this->alloc;
+			}
+
+			//gets the compare function object
+			Compare& get_compare() noexcept
+			{
+				return this->cmp;
+			}
+
+			const Compare& get_compare() const noexcept
+			{
+				return this->cmp;
+			}
+
+		private:
+			//checks if the node pointed by ptr is red (a null link is black)
+			static bool is_red(const_node_pointer ptr) noexcept
+			{
+				return ptr != nullptr && ptr->color == color_type::red;
+			}
+
+			//replaces the subtree rooted in the node pointed by pos with the subtree rooted in the node pointed by ptr
+			void transplant(node_pointer pos, node_pointer ptr) noexcept
+			{
+				if (pos->parent == nullptr)
+					this->root = ptr;
+				else if (pos == pos->parent->left)
+					pos->parent->left  = ptr;
+				else
+					pos->parent->right = ptr;
+
+				if (ptr != nullptr)
+					ptr->parent = pos->parent;
+			}
+
+			//performs a left rotation, the right child takes the place of the node pointed by ptr
+			void rotate_left(node_pointer ptr) noexcept
+			{
+				auto right { ptr->right };
+
+				ptr->right = right->left;
+
+				if (right->left != nullptr)
+					right->left->parent = ptr;
+
+				transplant(ptr, right);
+
+				right->left = ptr;
+				ptr->parent = right;
+			}
+
+			//performs a right rotation, the left child takes the place of the node pointed by ptr
+			void rotate_right(node_pointer ptr) noexcept
+			{
+				auto left { ptr->left };
+
+				ptr->left = left->right;
+
+				if (left->right != nullptr)
+					left->right->parent = ptr;
+
+				transplant(ptr, left);
+
+				left->right = ptr;
+				ptr->parent = left;
+			}
+
+			/*
+			 *	restores the properties after the red node pointed by ptr is inserted
+			 *
+			 *	1. the uncle is red:   recolors the parent and the uncle black, the grandparent red, goes on from the grandparent
+			 *	2. the uncle is black: rotates the node to the outside of the grandparent if it is inside (zig-zag),
+			 *	                       then rotates the grandparent to the uncle side and swaps their colors, done
+			 */
+			void fix_insertion(node_pointer ptr) noexcept
+			{
+				for ( ; is_red(ptr->parent); )
+				{
+					auto parent      { ptr->parent };
+					auto grandparent { parent->parent };		//exists, the red parent is not the root
+
+					if (parent == grandparent->left)
+					{
+						auto uncle { grandparent->right };
+
+						if (is_red(uncle))
+						{
+							parent->color      = color_type::black;
+							uncle->color       = color_type::black;
+							grandparent->color = color_type::red;
+
+							ptr = grandparent;
+						}
+						else
+						{
+							if (ptr == parent->right)
+							{
+								rotate_left(parent);
+
+								std::swap(ptr, parent);
+							}
+
+							parent->color      = color_type::black;
+							grandparent->color = color_type::red;
+
+							rotate_right(grandparent);
+						}
+					}
+					else
+					{
+						auto uncle { grandparent->left };
+
+						if (is_red(uncle))
+						{
+							parent->color      = color_type::black;
+							uncle->color       = color_type::black;
+							grandparent->color = color_type::red;
+
+							ptr = grandparent;
+						}
+						else
+						{
+							if (ptr == parent->left)
+							{
+								rotate_right(parent);
+
+								std::swap(ptr, parent);
+							}
+
+							parent->color      = color_type::black;
+							grandparent->color = color_type::red;
+
+							rotate_left(grandparent);
+						}
+					}
+				}
+
+				this->root->color = color_type::black;
+			}
+
+			/*
+			 *	restores the properties after a black node is removed, the position of ptr (under parent) lacks one black
+			 *
+			 *	1. the sibling is red:                        rotates it up, the new sibling is black (goes on to 2 ~ 4)
+			 *	2. the sibling has no red child:              recolors the sibling red, the parent lacks one black then
+			 *	3. the near child of the sibling is red only: rotates it up to the sibling (goes on to 4)
+			 *	4. the far  child of the sibling is red:      rotates the sibling up to the parent and recolors, done
+			 */
+			void fix_removal(node_pointer ptr, node_pointer parent) noexcept
+			{
+				for ( ; ptr != this->root && !is_red(ptr); )
+				{
+					if (ptr == parent->left)
+					{
+						auto sibling { parent->right };		//exists, the removed black node had a black height of at least 1
+
+						if (is_red(sibling))
+						{
+							sibling->color = color_type::black;
+							parent->color  = color_type::red;
+
+							rotate_left(parent);
+
+							sibling = parent->right;
+						}
+
+						if ( !is_red(sibling->left) && !is_red(sibling->right) )
+						{
+							sibling->color = color_type::red;
+
+							ptr    = parent;
+							parent = ptr->parent;
+						}
+						else
+						{
+							if ( !is_red(sibling->right) )
+							{
+								sibling->left->color = color_type::black;
+								sibling->color       = color_type::red;
+
+								rotate_right(sibling);
+
+								sibling = parent->right;
+							}
+
+							sibling->color        = parent->color;
+							parent->color         = color_type::black;
+							sibling->right->color = color_type::black;
+
+							rotate_left(parent);
+
+							ptr = this->root;
+						}
+					}
+					else
+					{
+						auto sibling { parent->left };
+
+						if (is_red(sibling))
+						{
+							sibling->color = color_type::black;
+							parent->color  = color_type::red;
+
+							rotate_right(parent);
+
+							sibling = parent->left;
+						}
+
+						if ( !is_red(sibling->left) && !is_red(sibling->right) )
+						{
+							sibling->color = color_type::red;
+
+							ptr    = parent;
+							parent = ptr->parent;
+						}
+						else
+						{
+							if ( !is_red(sibling->left) )
+							{
+								sibling->right->color = color_type::black;
+								sibling->color        = color_type::red;
+
+								rotate_left(sibling);
+
+								sibling = parent->left;
+							}
+
+							sibling->color       = parent->color;
+							parent->color        = color_type::black;
+							sibling->left->color = color_type::black;
+
+							rotate_right(parent);
+
+							ptr = this->root;
+						}
+					}
+				}
+
+				if (ptr != nullptr)
+					ptr->color = color_type::black;
+			}
+	};
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+/*
+ *	static search tree in the Eytzinger layout (BFS order, the children of the element at index k are 2k and 2k + 1)
+ *
+ *	freeze() copies the elements of a binary search tree into one immutable array in O(n),
+ *	a search is a branchless descent (the next index is computed from the comparison result, no mispredicted branches)
+ *	and the block 4 levels below the current element is prefetched, so cache misses overlap instead of adding up
+ */
+
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include "binary_search_tree.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace cust					//customized / non-standard
+{
+	template<class T, class Compare = std::less<T>>
+	class eytzinger_tree
+	{
+		public:
+			using value_type      = T;
+			using size_type       = std::size_t;
+			using const_pointer   = const value_type*;
+			using const_reference = const value_type&;
+			using key_compare     = Compare;
+
+			//default constructor
+			eytzinger_tree() = default;
+
+			//constructor with a sorted range [first, last) of forward iterators (without duplicate values)
+			template<class ForwardIter>
+			eytzinger_tree(ForwardIter first, ForwardIter last)
+			{
+				elems.resize(static_cast<size_type>(std::distance(first, last)) + 1);
+
+				for (auto k { begin_index() }; k != 0; k = next_index(k))
+					elems[k] = *first++;
+			}
+
+			//gets the number of elements of the tree
+			size_type size() const noexcept
+			{
+				return elems.empty() ? 0 : elems.size() - 1;
+			}
+
+			//checks if the tree is empty
+			bool empty() const noexcept
+			{
+				return size() == 0;
+			}
+
+			//returns the function object that compares the elements
+			key_compare key_comp() const
+			{
+				return cmp;
+			}
+
+			//finds the element with the equivalent value, nullptr if there is no such element
+			const_pointer find(const value_type& value) const
+			{
+				auto ptr { lower_bound(value) };
+
+				return ptr == nullptr || cmp(value, *ptr) ? nullptr : ptr;
+			}
+
+			//checks if there is an element with the equivalent value
+			bool contains(const value_type& value) const
+			{
+				return find(value) != nullptr;
+			}
+
+			//finds the first element with the value that is not less than the function argument, nullptr if there is no such element
+			const_pointer lower_bound(const value_type& value) const
+			{
+				return search(value, [this](const value_type& elem, const value_type& val) { return cmp(elem, val); });
+			}
+
+			//finds the first element with the value that is greater than the function argument, nullptr if there is no such element
+			const_pointer upper_bound(const value_type& value) const
+			{
+				return search(value, [this](const value_type& elem, const value_type& val) { return !cmp(val, elem); });
+			}
+
+			//performs an inorder traversal of the tree (in ascending order)
+			template<class Fn>
+			void traverse(Fn func) const
+			{
+				for (auto k { begin_index() }; k != 0; k = next_index(k))
+					func(elems[k]);
+			}
+
+		private:
+			//the number of elements in a cache line, the elements 4 levels below an element are contiguous
+			static constexpr size_type block { sizeof(value_type) < 64 ? 64 / sizeof(value_type) : 1 };
+
+			//hints the CPU to load the cache line of the address
+			static void prefetch(const void* ptr) noexcept
+			{
+#if defined(__GNUC__) || defined(__clang__)
+				__builtin_prefetch(ptr);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+				_mm_prefetch(static_cast<const char*>(ptr), _MM_HINT_T0);
+#else
+				static_cast<void>(ptr);
+#endif
+			}
+
+			/*
+			 *	descends from the root to the right while go_right(element, value) holds, otherwise to the left,
+			 *	the result is the last element where it turned left (the first one of the inorder not satisfying go_right)
+			 *
+			 *	the index after falling off the tree is k = (the result index, 1 followed by the right turns below it) in binary,
+			 *	so the trailing ones and one more bit are shifted out to get the result (0 if it never turned left)
+			 */
+			template<class Pred>
+			const_pointer search(const value_type& value, Pred go_right) const
+			{
+				size_type n { size() };
+				size_type k { 1 };
+
+				for ( ; k <= n; )
+				{
+					if (k * block <= n)
+						prefetch(elems.data() + k * block);
+
+					k = 2 * k + static_cast<size_type>(go_right(elems[k], value));
+				}
+
+				k >>= std::countr_one(k) + 1;
+
+				return k == 0 ? nullptr : elems.data() + k;
+			}
+
+			//gets the index of the min element, 0 if the tree is empty
+			size_type begin_index() const noexcept
+			{
+				size_type k { 1 };
+
+				for ( ; 2 * k <= size(); k *= 2);
+
+				return k <= size() ? k : 0;
+			}
+
+			//gets the index of the inorder successor of the element at index k, 0 after the max element
+			size_type next_index(size_type k) const noexcept
+			{
+				if (2 * k + 1 <= size())
+				{
+					for (k = 2 * k + 1; 2 * k <= size(); k *= 2);
+
+					return k;
+				}
+
+				return k >> (std::countr_one(k) + 1);
+			}
+
+			std::vector<value_type> elems {};		//the elements in the Eytzinger order from index 1 (index 0 is unused)
+			Compare                 cmp   {};		//element comparison function
+	};
+
+	//makes an immutable Eytzinger copy of a binary search tree (or a tree derived from it, e.g. AVL_tree) in O(n)
+	template<class T, class node_type, class Compare, class Allocator, class Rebalance>
+	eytzinger_tree<T, Compare> freeze(const binary_search_tree<T, node_type, Compare, Allocator, Rebalance>& tree)
+	{
+		std::vector<T> sorted {};
+
+		sorted.reserve(tree.size());
+
+		tree.traverse([&sorted](const T& value) { sorted.push_back(value); });
+
+		return eytzinger_tree<T, Compare>(sorted.cbegin(), sorted.cend());
+	}
+}
@@ -0,0 +1,513 @@
+#pragma once
+
+/*
+ *	parallel traversal of a binary tree by fork-join over the subtrees on a work-stealing thread pool
+ *
+ *	a node forks its left subtree as a task, processes itself and its right subtree, then joins the left task,
+ *	an idle thread steals the oldest task of another thread (the biggest subtree near the root),
+ *	below the cutoff depth a subtree is processed sequentially (forking a small subtree costs more than it saves)
+ *
+ *	works with any tree with get_root() whose nodes have left, right and value
+ */
+
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cust					//customized / non-standard
+{
+	/*
+	 *	thread pool for fork-join computations, a deque of tasks per thread
+	 *
+	 *	the thread calling run() takes part as the worker 0, one computation runs at a time (run() calls are serialized,
+	 *	so run() must not be called inside a computation of the same pool),
+	 *	a worker pushes and pops its own tasks at the back, the others steal them at the front
+	 */
+	class work_stealing_pool
+	{
+		public:
+			using size_type = std::size_t;
+
+			//a task forked in a computation, it lives in the frame of the forking function until it is joined
+			class task
+			{
+				public:
+					virtual ~task() = default;
+
+				protected:
+					virtual void execute() = 0;
+
+				private:
+					friend class work_stealing_pool;
+
+					//runs the task and records an exception thrown by it
+					void run() noexcept
+					{
+						try
+						{
+							execute();
+						}
+						catch (...)
+						{
+							error = std::current_exception();
+						}
+
+						done.store(true, std::memory_order_release);
+					}
+
+					std::atomic<bool>  done  { false };
+					std::exception_ptr error {};
+			};
+
+			//constructor with the number of threads (the calling thread of run() included), at least 1
+			explicit work_stealing_pool(size_type threads = std::thread::hardware_concurrency())
+				: queues(threads == 0 ? 1 : threads)
+			{
+				workers.reserve(queues.size() - 1);
+
+				for (size_type i { 1 }; i < queues.size(); ++i)
+					workers.emplace_back([this, i]() { work(i); });
+			}
+
+			work_stealing_pool(const work_stealing_pool&) = delete;
+
+			work_stealing_pool& operator = (const work_stealing_pool&) = delete;
+
+			//destructor, stops and joins the threads
+			~work_stealing_pool()
+			{
+				{
+					std::lock_guard<std::mutex> lock { state_mutex };
+
+					stopping = true;
+				}
+
+				wake.notify_all();
+
+				for (auto& thread : workers)
+					thread.join();
+			}
+
+			//gets the number of threads (the calling thread of run() included)
+			size_type size() const noexcept
+			{
+				return queues.size();
+			}
+
+			//runs the computation func() on this thread as the worker 0, fork() and join() are used inside it
+			template<class Fn>
+			decltype(auto) run(Fn func)
+			{
+				std::lock_guard<std::mutex> run_lock { run_mutex };
+
+				set_active(true);
+
+				struct deactivate
+				{
+					work_stealing_pool* pool;
+
+					~deactivate()
+					{
+						pool->set_active(false);
+					}
+				} guard { this };
+
+				auto& self { current() };
+				auto  prev { std::exchange(self, worker_id { this, 0 }) };
+
+				struct restore
+				{
+					worker_id& self;
+					worker_id  prev;
+
+					~restore()
+					{
+						self = prev;
+					}
+				} restore_guard { self, prev };
+
+				return func();
+			}
+
+			//pushes the task to the deque of this thread, it must be joined before it goes out of scope
+			void fork(task& t)
+			{
+				auto& q { queues[index()] };
+
+				std::lock_guard<std::mutex> lock { q.mutex };
+
+				q.tasks.push_back(&t);
+			}
+
+			//waits for the task by running other tasks, rethrows the exception thrown by the task
+			void join(task& t)
+			{
+				wait(t);
+
+				if (t.error)
+					std::rethrow_exception(t.error);
+			}
+
+			//waits for the task by running other tasks (without rethrowing)
+			void wait(task& t) noexcept
+			{
+				for (auto i { index() }; !t.done.load(std::memory_order_acquire); )
+				{
+					auto next { pop(i) };
+
+					if (next == nullptr)
+						next = steal(i);
+
+					if (next != nullptr)
+						next->run();
+					else
+						std::this_thread::yield();
+				}
+			}
+
+		private:
+			struct task_queue
+			{
+				std::mutex        mutex {};
+				std::deque<task*> tasks {};
+			};
+
+			struct worker_id
+			{
+				work_stealing_pool* pool  { nullptr };
+				size_type           index { 0 };
+			};
+
+			//the pool and the index of the calling thread
+			static worker_id& current() noexcept
+			{
+				thread_local worker_id id {};
+
+				return id;
+			}
+
+			//the index of the calling thread in this pool
+			size_type index() const noexcept
+			{
+				return current().pool == this ? current().index : 0;
+			}
+
+			//takes the newest task of the worker i
+			task* pop(size_type i)
+			{
+				auto& q { queues[i] };
+
+				std::lock_guard<std::mutex> lock { q.mutex };
+
+				if (q.tasks.empty())
+					return nullptr;
+
+				auto t { q.tasks.back() };
+
+				q.tasks.pop_back();
+
+				return t;
+			}
+
+			//takes the oldest task of another worker, from the next one round
+			task* steal(size_type i)
+			{
+				for (size_type k { 1 }; k < queues.size(); ++k)
+				{
+					auto& q { queues[(i + k) % queues.size()] };
+
+					std::unique_lock<std::mutex> lock { q.mutex, std::try_to_lock };
+
+					if (lock.owns_lock() && !q.tasks.empty())
+					{
+						auto t { q.tasks.front() };
+
+						q.tasks.pop_front();
+
+						return t;
+					}
+				}
+
+				return nullptr;
+			}
+
+			//marks the start / end of a computation, the threads sleep between computations
+			void set_active(bool value)
+			{
+				{
+					std::lock_guard<std::mutex> lock { state_mutex };
+
+					active = value;
+				}
+
+				if (value)
+					wake.notify_all();
+			}
+
+			//the loop of the worker i (i > 0)
+			void work(size_type i)
+			{
+				current() = worker_id { this, i };
+
+				for (;;)
+				{
+					{
+						std::unique_lock<std::mutex> lock { state_mutex };
+
+						wake.wait(lock, [this]() { return stopping || active; });
+
+						if (stopping)
+							return;
+					}
+
+					auto t { pop(i) };
+
+					if (t == nullptr)
+						t = steal(i);
+
+					if (t != nullptr)
+						t->run();
+					else
+						std::this_thread::yield();
+				}
+			}
+
+			std::vector<task_queue>  queues      {};			//the deques of the workers
+			std::vector<std::thread> workers     {};			//the threads of the workers 1 ~ size() - 1
+			std::mutex               run_mutex   {};			//serializes the computations
+			std::mutex               state_mutex {};
+			std::condition_variable  wake        {};
+			bool                     active      { false };		//a computation is running
+			bool                     stopping    { false };		//the pool is being destroyed
+	};
+
+	//gets the pool shared by the parallel traversals, with a thread per hardware thread
+	inline work_stealing_pool& default_pool()
+	{
+		static work_stealing_pool pool {};
+
+		return pool;
+	}
+
+	//gets the default cutoff depth, enough subtrees to keep every thread busy (about 8 tasks per thread)
+	inline std::size_t default_cutoff_depth(const work_stealing_pool& pool) noexcept
+	{
+		return static_cast<std::size_t>(std::bit_width(pool.size())) + 3;
+	}
+
+	namespace parallel_detail
+	{
+		//reduces the subtree rooted in the root node sequentially in inorder
+		template<class NodePtr, class T, class Reduce, class Transform>
+		T reduce_subtree(NodePtr root, T init, Reduce& reduce, Transform& transform)
+		{
+			std::vector<NodePtr> stk {};
+
+			for (auto ptr { root }; ptr != nullptr || !stk.empty(); )
+			{
+				if (ptr != nullptr)
+				{
+					stk.push_back(ptr);
+
+					ptr = ptr->left;
+				}
+				else
+				{
+					init = reduce(std::move(init), transform(stk.back()->value));
+
+					ptr = stk.back()->right;
+
+					stk.pop_back();
+				}
+			}
+
+			return init;
+		}
+
+		//reduces the subtree rooted in the root node, forks the left subtrees above the cutoff depth
+		template<class NodePtr, class T, class Reduce, class Transform>
+		T reduce_forked(work_stealing_pool& pool, NodePtr root, const T& identity, Reduce& reduce, Transform& transform, std::size_t depth)
+		{
+			if (root == nullptr)
+				return identity;
+
+			if (depth == 0)
+				return reduce_subtree(root, identity, reduce, transform);
+
+			struct left_task : work_stealing_pool::task
+			{
+				left_task(work_stealing_pool& pool, NodePtr root, const T& identity, Reduce& reduce, Transform& transform, std::size_t depth)
+					: pool { pool }, root { root }, identity { identity }, reduce { reduce }, transform { transform }, depth { depth }
+				{
+				}
+
+				void execute() override
+				{
+					result = reduce_forked(pool, root, identity, reduce, transform, depth);
+				}
+
+				work_stealing_pool& pool;
+				NodePtr             root;
+				const T&            identity;
+				Reduce&             reduce;
+				Transform&          transform;
+				std::size_t         depth;
+				T                   result { identity };
+			} left { pool, root->left, identity, reduce, transform, depth - 1 };
+
+			pool.fork(left);
+
+			auto right = [&]() {
+				try
+				{
+					return reduce(transform(root->value), reduce_forked(pool, root->right, identity, reduce, transform, depth - 1));
+				}
+				catch (...)
+				{
+					//the task refers to this frame, it must finish before the frame is left
+					pool.wait(left);
+
+					throw;
+				}
+			}();
+
+			pool.join(left);
+
+			return reduce(std::move(left.result), std::move(right));
+		}
+
+		//applies the function to the values of the subtree rooted in the root node, forks the left subtrees above the cutoff depth
+		template<class NodePtr, class Fn>
+		void for_each_forked(work_stealing_pool& pool, NodePtr root, Fn& func, std::size_t depth)
+		{
+			if (root == nullptr)
+				return;
+
+			if (depth == 0)
+			{
+				std::vector<NodePtr> stk { root };
+
+				for ( ; !stk.empty(); )
+				{
+					auto ptr { stk.back() };
+
+					stk.pop_back();
+
+					func(ptr->value);
+
+					if (ptr->right != nullptr)
+						stk.push_back(ptr->right);
+
+					if (ptr->left != nullptr)
+						stk.push_back(ptr->left);
+				}
+
+				return;
+			}
+
+			struct left_task : work_stealing_pool::task
+			{
+				left_task(work_stealing_pool& pool, NodePtr root, Fn& func, std::size_t depth) : pool { pool }, root { root }, func { func }, depth { depth }
+				{
+				}
+
+				void execute() override
+				{
+					for_each_forked(pool, root, func, depth);
+				}
+
+				work_stealing_pool& pool;
+				NodePtr             root;
+				Fn&                 func;
+				std::size_t         depth;
+			} left { pool, root->left, func, depth - 1 };
+
+			pool.fork(left);
+
+			try
+			{
+				func(root->value);
+
+				for_each_forked(pool, root->right, func, depth - 1);
+			}
+			catch (...)
+			{
+				//the task refers to this frame, it must finish before the frame is left
+				pool.wait(left);
+
+				throw;
+			}
+
+			pool.join(left);
+		}
+	}
+
+	/*
+	 *	reduces transform(value) of all elements of the tree with reduce on the pool
+	 *
+	 *	identity must be the identity of reduce, and reduce must be associative (the inorder of the values is kept,
+	 *	so it need not be commutative), transform and reduce are called by several threads at the same time,
+	 *	an exception thrown by them is rethrown after all forked tasks finish
+	 */
+	template<class Tree, class T, class Reduce, class Transform>
+	T parallel_reduce(work_stealing_pool& pool, const Tree& tree, T identity, Reduce reduce, Transform transform, std::size_t cutoff_depth)
+	{
+		return pool.run([&]() {
+			return parallel_detail::reduce_forked(pool, tree.get_root(), identity, reduce, transform, cutoff_depth);
+		});
+	}
+
+	template<class Tree, class T, class Reduce, class Transform>
+	T parallel_reduce(work_stealing_pool& pool, const Tree& tree, T identity, Reduce reduce, Transform transform)
+	{
+		return parallel_reduce(pool, tree, std::move(identity), reduce, transform, default_cutoff_depth(pool));
+	}
+
+	template<class Tree, class T, class Reduce, class Transform>
+	T parallel_reduce(const Tree& tree, T identity, Reduce reduce, Transform transform)
+	{
+		return parallel_reduce(default_pool(), tree, std::move(identity), reduce, transform);
+	}
+
+	//reduces the values of all elements of the tree with reduce on the default pool
+	template<class Tree, class T, class Reduce>
+	T parallel_reduce(const Tree& tree, T identity, Reduce reduce)
+	{
+		return parallel_reduce(tree, std::move(identity), reduce, [](const auto& value) -> const auto& { return value; });
+	}
+
+	/*
+	 *	applies the function to the values of all elements of the tree on the pool, in no particular order
+	 *
+	 *	the function is called by several threads at the same time (for different elements),
+	 *	the values may be modified through a non-const tree (without changing the order of a search tree),
+	 *	the shape of the tree must not be changed
+	 */
+	template<class Tree, class Fn>
+	void parallel_for_each(work_stealing_pool& pool, Tree& tree, Fn func, std::size_t cutoff_depth)
+	{
+		pool.run([&]() {
+			parallel_detail::for_each_forked(pool, tree.get_root(), func, cutoff_depth);
+		});
+	}
+
+	template<class Tree, class Fn>
+	void parallel_for_each(work_stealing_pool& pool, Tree& tree, Fn func)
+	{
+		parallel_for_each(pool, tree, func, default_cutoff_depth(pool));
+	}
+
+	template<class Tree, class Fn>
+	void parallel_for_each(Tree& tree, Fn func)
+	{
+		parallel_for_each(default_pool(), tree, func);
+	}
+}
@@ -7,10 +7,268 @@
 #include <utility>
 #include <stack>
 #include <queue>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
 #include <type_traits>
+#include <array>
+#include <iterator>
+#include <ranges>
+#include <atomic>
 
 namespace cust					//customized / non-standard
 {
+	//the order of a traversal, of a lazy traversal by iterators or of a sequence to build a binary tree with the inorder sequence
+	enum class traversal : char { preorder, inorder, postorder, levelorder };
+
+	/*
+	 *	stack with the first N elements in place, only a deeper one allocates (the rest grows geometrically on the heap)
+	 *
+	 *	the stacks of a traversal hold at most the nodes of one root-to-leaf path, so N = 32 covers a balanced tree
+	 *	of 2^32 nodes without any allocation, it is also a container of std::stack (back / push_back / pop_back)
+	 */
+	template<class T, std::size_t N = 32>
+	class inline_stack
+	{
+		public:
+			using value_type      = T;
+			using size_type       = std::size_t;
+			using reference       = value_type&;
+			using const_reference = const value_type&;
+
+			//checks if the stack is empty
+			bool empty() const noexcept
+			{
+				return sz == 0;
+			}
+
+			//gets the number of elements of the stack
+			size_type size() const noexcept
+			{
+				return sz;
+			}
+
+			//access the top element
+			reference back() noexcept
+			{
+				return sz <= N ? elems[sz - 1] : spill.back();
+			}
+
+			const_reference back() const noexcept
+			{
+				return sz <= N ? elems[sz - 1] : spill.back();
+			}
+
+			//pushes an element on the top
+			void push_back(const value_type& value)
+			{
+				if (sz < N)
+					elems[sz] = value;
+				else
+					spill.push_back(value);
+
+				++sz;
+			}
+
+			//removes the top element
+			void pop_back() noexcept
+			{
+				if (N < sz)
+					spill.pop_back();
+
+				--sz;
+			}
+
+		private:
+			std::array<value_type, N> elems {};		//the first N elements
+			std::vector<value_type>   spill {};		//the elements above the first N
+			size_type                 sz    { 0 };		//the number of elements of the stack
+	};
+
+	/*
+	 *	forward iterator of a traversal in the order, it yields the values of the nodes one by one
+	 *
+	 *	preorder:   the stack holds the right children to visit later
+	 *	inorder:    the stack holds the ancestors whose values are not yet visited
+	 *	postorder:  the stack holds all ancestors of the current node
+	 *	levelorder: the queue holds the nodes of the next levels
+	 *
+	 *	the nodes must not be modified while the iterator is in use, it is equal to std::default_sentinel at the end
+	 */
+	template<class Node, traversal Order>
+	class traversal_iterator
+	{
+		private:
+			using node_pointer   = const Node*;
+			using container_type = std::conditional_t<Order == traversal::levelorder, std::queue<node_pointer>, inline_stack<node_pointer>>;
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type        = typename Node::value_type;
+			using difference_type   = std::ptrdiff_t;
+			using pointer           = const value_type*;
+			using reference         = const value_type&;
+
+			//default constructor (at the end)
+			traversal_iterator() = default;
+
+			//constructor with the root node, at the first node of the order
+			explicit traversal_iterator(node_pointer root)
+			{
+				if (root == nullptr)
+					return;
+
+				if constexpr (Order == traversal::inorder)
+				{
+					push_left(root);
+					pop();
+				}
+				else if constexpr (Order == traversal::postorder)
+					descend(root);
+				else
+					cur = root;
+			}
+
+			reference operator * () const noexcept
+			{
+				return cur->value;
+			}
+
+			pointer operator -> () const noexcept
+			{
+				return std::addressof(cur->value);
+			}
+
+			traversal_iterator& operator ++ ()
+			{
+				if constexpr (Order == traversal::preorder)
+				{
+					if (cur->left != nullptr)
+					{
+						if (cur->right != nullptr)
+							pending.push_back(cur->right);
+
+						cur = cur->left;
+					}
+					else if (cur->right != nullptr)
+						cur = cur->right;
+					else
+						pop();
+				}
+				else if constexpr (Order == traversal::inorder)
+				{
+					push_left(cur->right);
+					pop();
+				}
+				else if constexpr (Order == traversal::postorder)
+				{
+					//the right sibling subtree is next if the current node is a left child, otherwise the parent
+					if ( !pending.empty() && pending.back()->left == cur && pending.back()->right != nullptr )
+						descend(pending.back()->right);
+					else
+						pop();
+				}
+				else
+				{
+					if (cur->left != nullptr)
+						pending.push(cur->left);
+
+					if (cur->right != nullptr)
+						pending.push(cur->right);
+
+					pop();
+				}
+
+				return *this;
+			}
+
+			traversal_iterator operator ++ (int)
+			{
+				auto tmp { *this };
+
+				++*this;
+
+				return tmp;
+			}
+
+			friend bool operator == (const traversal_iterator& lhs, const traversal_iterator& rhs) noexcept
+			{
+				return lhs.cur == rhs.cur;
+			}
+
+			friend bool operator == (const traversal_iterator& iter, std::default_sentinel_t) noexcept
+			{
+				return iter.cur == nullptr;
+			}
+
+		private:
+			//moves to the next pending node, nullptr if there is none
+			void pop()
+			{
+				if (pending.empty())
+					cur = nullptr;
+				else if constexpr (Order == traversal::levelorder)
+				{
+					cur = pending.front();
+					pending.pop();
+				}
+				else
+				{
+					cur = pending.back();
+					pending.pop_back();
+				}
+			}
+
+			//pushes the node and its left descendants
+			void push_left(node_pointer ptr)
+			{
+				for ( ; ptr != nullptr; ptr = ptr->left)
+					pending.push_back(ptr);
+			}
+
+			//moves to the first node of the subtree in postorder (the leaf reached by preferring the left child)
+			void descend(node_pointer ptr)
+			{
+				for ( ; ptr->left != nullptr || ptr->right != nullptr; ptr = ptr->left != nullptr ? ptr->left : ptr->right)
+					pending.push_back(ptr);
+
+				cur = ptr;
+			}
+
+			node_pointer   cur     { nullptr };		//the current node, nullptr at the end
+			container_type pending {};			//the nodes to visit later (see above)
+	};
+
+	//lazy view of the values of a tree in the order, for range-based for loops and the algorithms of std::ranges
+	template<class Node, traversal Order>
+	class traversal_range : public std::ranges::view_interface<traversal_range<Node, Order>>
+	{
+		public:
+			using iterator = traversal_iterator<Node, Order>;
+
+			//default constructor (an empty range)
+			traversal_range() = default;
+
+			//constructor with the root node
+			explicit traversal_range(const Node* root) noexcept : root { root }
+			{
+			}
+
+			iterator begin() const
+			{
+				return iterator(root);
+			}
+
+			std::default_sentinel_t end() const noexcept
+			{
+				return std::default_sentinel;
+			}
+
+		private:
+			const Node* root { nullptr };
+	};
+
 	template<class T>
 	struct binary_tree_node
 	{
@@ -69,11 +327,165 @@ namespace cust					//customized / non-standard
 			std::allocator_traits<Allocator>::deallocate(alloc, ptr, 1);
 		}
 
-		//copies the subtree rooted in the src node
+		//copies the subtree rooted in the src node (preorder with an explicit stack of the source nodes and the links to fill in)
 		template<class Allocator>
 		[[nodiscard]] static node_pointer copy_nodes(Allocator& alloc, node_pointer src)
 		{
-			return src == nullptr ? nullptr : new_one_node(alloc, copy_nodes(alloc, src->left), copy_nodes(alloc, src->right), src->value);
+			std::stack<std::pair<node_pointer, node_pointer*>> stk {};
+			node_pointer root { nullptr };
+
+			if (src != nullptr)
+				stk.emplace(src, &root);
+
+			for ( ; !stk.empty(); )
+			{
+				auto [ptr, link] = stk.top();
+
+				stk.pop();
+
+				*link = new_node(alloc, ptr->value);
+
+				//stack is FILO, push the right child node first
+				if (ptr->right != nullptr)
+					stk.emplace(ptr->right, &(*link)->right);
+
+				if (ptr->left != nullptr)
+					stk.emplace(ptr->left,  &(*link)->left);
+			}
+
+			return root;
+		}
+
+		/*
+		 *	Given the sequences of traversal results of preorder / postorder / levelorder (xorder) and inorder,
+		 *	construct the unique binary tree in O(n)
+		 *
+		 *	1. indexes the positions of the values in xorder by a hash table
+		 *	2. a node is before all nodes of its subtree in preorder and levelorder (after them in postorder),
+		 *	   and its subtree is a contiguous range of inorder, so the tree is the Cartesian tree of inorder
+		 *	   with the position in xorder as the priority (the root has the min priority of its range)
+		 *	3. builds the Cartesian tree by a stack of the right spine in one pass of inorder
+		 *	4. checks the tree against xorder in one more pass, a pair of inconsistent sequences has no binary tree at all
+		 *	   (e.g. preorder 1 2 3 and inorder 3 1 2), the Cartesian tree of it does not reproduce xorder
+		 *
+		 *	throws std::invalid_argument if order is inorder (the shape is not unique then), a value is duplicate,
+		 *	the two sequences do not have the same values (nothing is allocated then) or they are inconsistent (the nodes are freed),
+		 *	the values must be hashable by std::hash
+		 */
+		template<class Allocator>
+		[[nodiscard]] static node_pointer build_nodes(Allocator& alloc, traversal order, const value_type* xorder, const value_type* inorder, std::size_t sz)
+		{
+			std::unordered_map<value_type, std::size_t> index    {};
+			std::vector<std::size_t>                    priority (sz);
+			std::vector<bool>                           used     (sz);
+
+			if (order == traversal::inorder)
+				throw std::invalid_argument("failed to build the binary tree: xorder must be preorder, postorder or levelorder");
+
+			index.reserve(sz);
+
+			for (std::size_t i { 0 }; i != sz; ++i)
+			{
+				if ( !index.emplace(xorder[i], order == traversal::postorder ? sz - 1 - i : i).second )
+					throw std::invalid_argument("failed to build the binary tree: duplicate value in the traversal sequence");
+			}
+
+			for (std::size_t i { 0 }; i != sz; ++i)
+			{
+				auto iter { index.find(inorder[i]) };
+
+				if (iter == index.end() || used[iter->second])
+					throw std::invalid_argument("failed to build the binary tree: the traversal sequences do not have the same values");
+
+				used[iter->second] = true;
+				priority[i]        = iter->second;
+			}
+
+			//the right spine of the tree built so far, from the root to the last node
+			std::vector<std::pair<node_pointer, std::size_t>> spine {};
+
+			try
+			{
+				for (std::size_t i { 0 }; i != sz; ++i)
+				{
+					auto         ptr  { new_node(alloc, inorder[i]) };
+					node_pointer last { nullptr };
+
+					for ( ; !spine.empty() && priority[i] < spine.back().second; spine.pop_back())
+						last = spine.back().first;
+
+					ptr->left = last;
+
+					if ( !spine.empty() )
+						spine.back().first->right = ptr;
+
+					spine.emplace_back(ptr, priority[i]);
+				}
+
+				//preorder and levelorder, or postorder backward (the root, the right subtree, the left subtree)
+				std::deque<node_pointer> pending {};
+
+				if ( !spine.empty() )
+					pending.push_back(spine.front().first);
+
+				for (std::size_t k { 0 }; !pending.empty(); ++k)
+				{
+					node_pointer ptr { nullptr };
+
+					if (order == traversal::levelorder)
+					{
+						ptr = pending.front();
+
+						pending.pop_front();
+					}
+					else
+					{
+						ptr = pending.back();
+
+						pending.pop_back();
+					}
+
+					if ( !(ptr->value == xorder[order == traversal::postorder ? sz - 1 - k : k]) )
+						throw std::invalid_argument("failed to build the binary tree: the traversal sequences are inconsistent");
+
+					//a stack for preorder pushes the right child first, a queue for levelorder and a stack for postorder backward the left one
+					auto first  { order == traversal::preorder ? ptr->right : ptr->left  };
+					auto second { order == traversal::preorder ? ptr->left  : ptr->right };
+
+					if (first != nullptr)
+						pending.push_back(first);
+
+					if (second != nullptr)
+						pending.push_back(second);
+				}
+			}
+			catch (...)
+			{
+				//the nodes built so far form a tree rooted in the bottom of the spine
+				std::stack<node_pointer> stk {};
+
+				if ( !spine.empty() )
+					stk.push(spine.front().first);
+
+				for ( ; !stk.empty(); )
+				{
+					auto ptr { stk.top() };
+
+					stk.pop();
+
+					if (ptr->left != nullptr)
+						stk.push(ptr->left);
+
+					if (ptr->right != nullptr)
+						stk.push(ptr->right);
+
+					delete_one_node(alloc, ptr);
+				}
+
+				throw;
+			}
+
+			return spine.empty() ? nullptr : spine.front().first;
 		}
 
 		node_pointer left  { nullptr };			//pointer pointing to left  child node
@@ -118,7 +530,14 @@ namespace cust					//customized / non-standard
 				binary_tree(const_pointer preorder, const_pointer inorder, const_pointer postorder, size_type sz)
 				{
 					if (inorder != nullptr && 0 < sz)
-						root = build_tree(preorder != nullptr ? preorder : postorder, inorder, sz, preorder != nullptr);
+						root = node_type::build_nodes(alloc, preorder != nullptr ? traversal::preorder : traversal::postorder, preorder != nullptr ? preorder : postorder, inorder, sz);
+				}
+
+				//constructor with the sequences of traversal results of preorder / postorder / levelorder (xorder) and inorder, O(n)
+				binary_tree(traversal order, const_pointer xorder, const_pointer inorder, size_type sz)
+				{
+					if (xorder != nullptr && inorder != nullptr && 0 < sz)
+						root = node_type::build_nodes(alloc, order, xorder, inorder, sz);
 				}
 
 				//destructor
@@ -148,7 +567,7 @@ namespace cust					//customized / non-standard
 				}
 
 				//gets the number of elements of the tree
-				size_type size() const noexcept
+				size_type size() const
 				{
 					return size(root);
 				}
@@ -156,11 +575,11 @@ namespace cust					//customized / non-standard
 				//checks if the tree is empty
 				bool empty() const noexcept
 				{
-					return size() == 0;
+					return root == nullptr;
 				}
 
 				//gets the height of the tree, -1 if the tree is empty
-				difference_type height() const noexcept
+				difference_type height() const
 				{
 					return height(root);
 				}
@@ -206,6 +625,30 @@ namespace cust					//customized / non-standard
 					levelorder(que, func);
 				}
 
+				//gets a lazy view of the values in preorder
+				traversal_range<node_type, traversal::preorder> preorder() const noexcept
+				{
+					return traversal_range<node_type, traversal::preorder>(root);
+				}
+
+				//gets a lazy view of the values in inorder
+				traversal_range<node_type, traversal::inorder> inorder() const noexcept
+				{
+					return traversal_range<node_type, traversal::inorder>(root);
+				}
+
+				//gets a lazy view of the values in postorder
+				traversal_range<node_type, traversal::postorder> postorder() const noexcept
+				{
+					return traversal_range<node_type, traversal::postorder>(root);
+				}
+
+				//gets a lazy view of the values in levelorder
+				traversal_range<node_type, traversal::levelorder> levelorder() const noexcept
+				{
+					return traversal_range<node_type, traversal::levelorder>(root);
+				}
+
 				//adds the root node if the tree is empty
 				template<class... Args>
 				node_pointer add_root(Args&&... args)
@@ -236,51 +679,87 @@ namespace cust					//customized / non-standard
 					return root;
 				}
 
+				const_node_pointer get_root() const noexcept
+				{
+					return root;
+				}
+
 			protected:
-				/*
-				 *	Given the sequences of preorder/postorder and inorder traversal, construct the unique binary tree
-				 *
-				 *	xorder:
-				 *			preorder,  if flag is true
-				 *			postorder, if flag is false
-				 */
-				node_pointer build_tree(const_pointer xorder, const_pointer inorder, size_type sz, bool flag = true)
+				//gets the number of elements of the subtree rooted in the ptr node (the right children are kept on a stack)
+				size_type size(node_pointer ptr) const
 				{
-					auto      ptr { xorder };
-					size_type i   { 0 };
+					std::stack<node_pointer, inline_stack<node_pointer>> stk {};
+					size_type cnt { 0 };
+
+					for ( ; ptr != nullptr || !stk.empty(); ++cnt)
+					{
+						if (ptr == nullptr)
+						{
+							ptr = stk.top();
 
-					if (sz == 0)
-						return nullptr;
+							stk.pop();
+						}
 
-					if ( !flag )
-						ptr += sz - 1;
+						if (ptr->right != nullptr)
+							stk.push(ptr->right);
 
-					for ( ; i != sz && *ptr != inorder[i]; ++i);
+						ptr = ptr->left;
+					}
 
-					return node_type::new_one_node(alloc, build_tree(xorder + flag, inorder, i, flag), build_tree(xorder + (i + flag), inorder + i + 1, sz - i - 1, flag), *ptr);
+					return cnt;
 				}
 
-				//gets the number of elements of the subtree rooted in the ptr node
-				size_type size(node_pointer ptr) const noexcept
+				//gets the height of the ptr node (the right children are kept on a stack with their depths)
+				difference_type height(node_pointer ptr) const
 				{
-					return ptr == nullptr ? 0 : 1 + size(ptr->left) + size(ptr->right);
-				}
+					std::stack<std::pair<node_pointer, difference_type>, inline_stack<std::pair<node_pointer, difference_type>>> stk {};
+					difference_type h { -1 };
 
-				//gets the height of the ptr node
-				difference_type height(node_pointer ptr) const noexcept
-				{
-					return ptr == nullptr ? -1 : 1 + std::max(height(ptr->left), height(ptr->right));
+					for (difference_type d { 0 }; ptr != nullptr || !stk.empty(); ++d)
+					{
+						if (ptr == nullptr)
+						{
+							ptr = stk.top().first;
+							d   = stk.top().second;
+
+							stk.pop();
+						}
+
+						h = std::max(h, d);
+
+						if (ptr->right != nullptr)
+							stk.push({ ptr->right, d + 1 });
+
+						ptr = ptr->left;
+					}
+
+					return h;
 				}
 
-				//clear all elements of the subtree rooted in the ptr node
+				/*
+				 *	clears all elements of the subtree rooted in the ptr node
+				 *
+				 *	rotates the left child up until the node has no left child, then deletes the node and goes on with its right child
+				 *	(no recursion and no extra space, even for a degenerate tree)
+				 */
 				void clear(node_pointer ptr) noexcept
 				{
-					if (ptr != nullptr)
+					for (node_pointer tmp { nullptr }; ptr != nullptr; )
 					{
-						clear(ptr->left);
-						clear(ptr->right);
+						if (ptr->left != nullptr)
+						{
+							tmp        = ptr->left;
+							ptr->left  = tmp->right;
+							tmp->right = ptr;
+						}
+						else
+						{
+							tmp = ptr->right;
 
-						node_type::delete_one_node(alloc, ptr);
+							node_type::delete_one_node(alloc, ptr);
+						}
+
+						ptr = tmp;
 					}
 				}
 
@@ -375,19 +854,36 @@ namespace cust					//customized / non-standard
 				binary_tree(const binary_tree& other)
 				{
 					root = copy_nodes(other.root);
+					sz   = other.sz;
+					h    = other.h.load(std::memory_order_relaxed);
 				}
 
 				//move constructor
 				binary_tree(binary_tree&& other) noexcept
 				{
-					std::swap(root, other.root);
+					swap(other);
 				}
 
 				//constructor with the sequences of traversal results of preorder / postorder and inorder
 				binary_tree(const_pointer preorder, const_pointer inorder, const_pointer postorder, size_type sz)
 				{
 					if (inorder != nullptr && 0 < sz)
-						root = build_tree(preorder != nullptr ? preorder : postorder, inorder, sz, preorder != nullptr ? 1 : -1);
+					{
+						root     = node_type::build_nodes(alloc, preorder != nullptr ? traversal::preorder : traversal::postorder, preorder != nullptr ? preorder : postorder, inorder, sz);
+						this->sz = sz;
+						h        = unknown_height;
+					}
+				}
+
+				//constructor with the sequences of traversal results of preorder / postorder / levelorder (xorder) and inorder, O(n)
+				binary_tree(traversal order, const_pointer xorder, const_pointer inorder, size_type sz)
+				{
+					if (xorder != nullptr && inorder != nullptr && 0 < sz)
+					{
+						root     = node_type::build_nodes(alloc, order, xorder, inorder, sz);
+						this->sz = sz;
+						h        = unknown_height;
+					}
 				}
 
 				//destructor
@@ -399,9 +895,14 @@ namespace cust					//customized / non-standard
 				//copy assignment
 				binary_tree& operator = (const binary_tree& other)
 				{
-					clear();
+					if (this != &other)
+					{
+						clear();
 
-					root = copy_nodes(other.root);
+						root = copy_nodes(other.root);
+						sz   = other.sz;
+						h    = other.h.load(std::memory_order_relaxed);
+					}
 
 					return *this;
 				}
@@ -411,37 +912,28 @@ namespace cust					//customized / non-standard
 				{
 					clear();
 
-					std::swap(root, other.root);
+					swap(other);
 
 					return *this;
 				}
 
-				//gets the number of elements in the tree
-				size_type size() const
+				//exchanges the elements of the tree with those of other
+				void swap(binary_tree& other) noexcept
 				{
-					std::stack<node_pointer> stk {};
-					size_type sz { 0 };
-
-					if (root != nullptr)
-						stk.push(root);
-
-					for (node_pointer ptr { nullptr }; !stk.empty(); )
-					{
-						ptr = stk.top();
-
-						++sz;
-
-						stk.pop();
+					std::swap(root, other.root);
+					std::swap(sz,   other.sz);
 
-						//has the left  child
-						if (ptr->left != nullptr)
-							stk.push(ptr->left);
+					h = other.h.exchange(h.load(std::memory_order_relaxed), std::memory_order_relaxed);
+				}
 
-						//has the right child
-						if (ptr->right != nullptr)
-							stk.push(ptr->right);
-					}
-					
+				/*
+				 *	gets the number of elements of the tree in O(1)
+				 *
+				 *	the count is kept by add_root(), append_left(), append_right() and clear(),
+				 *	the links modified through get_root() are not counted
+				 */
+				size_type size() const noexcept
+				{
 					return sz;
 				}
 
@@ -451,34 +943,24 @@ namespace cust					//customized / non-standard
 					return size() == 0;
 				}
 
-				//gets the height of the tree, -1 if the tree is empty (using levelorder-like idea)
+				/*
+				 *	gets the height of the tree, -1 if the tree is empty (recomputed only after the tree is modified)
+				 *
+				 *	the cache is atomic, so concurrent calls of height() on a tree which is not modified are safe
+				 *	(each of them may compute the same height and store it)
+				 */
 				difference_type height() const
 				{
-					std::queue<node_pointer> que {};
-					difference_type          h   { -1 };
+					auto val { h.load(std::memory_order_relaxed) };
 
-					if (root != nullptr)
-						que.push(root);
-
-					for ( ; !que.empty(); ++h)
+					if (val == unknown_height)
 					{
-						for (auto cnt { que.size() }; cnt != 0; --cnt)
-						{
-							auto ptr { que.front() };
+						val = count_height();
 
-							que.pop();
-
-							//has the left  child
-							if (ptr->left != nullptr)
-								que.push(ptr->left);
-
-							//has the right child
-							if (ptr->right != nullptr)
-								que.push(ptr->right);
-						}
+						h.store(val, std::memory_order_relaxed);
 					}
 
-					return h;
+					return val;
 				}
 
 				//clears all elements of the tree
@@ -512,13 +994,15 @@ namespace cust					//customized / non-standard
 					}
 
 					root = nullptr;
+					sz   = 0;
+					h    = -1;
 				}
 
 				//performs a preorder traversal
 				template<class Fn>
 				void preorder(Fn func) const
 				{
-					std::stack<node_pointer> stk {};
+					std::stack<node_pointer, inline_stack<node_pointer>> stk {};
 
 					if (root != nullptr)
 						stk.push(root);
@@ -544,7 +1028,7 @@ namespace cust					//customized / non-standard
 				template<class Fn>
 				void inorder(Fn func) const
 				{
-					std::stack<node_pointer> stk {};
+					std::stack<node_pointer, inline_stack<node_pointer>> stk {};
 
 					for (auto ptr { root }; ptr != nullptr || !stk.empty(); )
 					{
@@ -569,7 +1053,7 @@ namespace cust					//customized / non-standard
 				template<class Fn>
 				void postorder(Fn func) const
 				{
-					std::stack<node_pointer> stk {};
+					std::stack<node_pointer, inline_stack<node_pointer>> stk {};
 
 					for (auto ptr { root }, prev { root }; ptr != nullptr || !stk.empty(); )
 					{
@@ -624,12 +1108,40 @@ namespace cust					//customized / non-standard
 					}
 				}
 
+				//gets a lazy view of the values in preorder
+				traversal_range<node_type, traversal::preorder> preorder() const noexcept
+				{
+					return traversal_range<node_type, traversal::preorder>(root);
+				}
+
+				//gets a lazy view of the values in inorder
+				traversal_range<node_type, traversal::inorder> inorder() const noexcept
+				{
+					return traversal_range<node_type, traversal::inorder>(root);
+				}
+
+				//gets a lazy view of the values in postorder
+				traversal_range<node_type, traversal::postorder> postorder() const noexcept
+				{
+					return traversal_range<node_type, traversal::postorder>(root);
+				}
+
+				//gets a lazy view of the values in levelorder
+				traversal_range<node_type, traversal::levelorder> levelorder() const noexcept
+				{
+					return traversal_range<node_type, traversal::levelorder>(root);
+				}
+
 				//adds the root node if the tree is empty
 				template<class... Args>
 				node_pointer add_root(Args&&... args)
 				{
 					if (empty())
+					{
 						root = node_type::new_node(alloc, std::forward<Args>(args)...);
+						sz   = 1;
+						h    = 0;
+					}
 
 					return root;
 				}
@@ -638,14 +1150,26 @@ namespace cust					//customized / non-standard
 				template<class... Args>
 				node_pointer append_left(node_pointer ptr, Args&&... args)
 				{
-					return node_type::append_left(alloc, ptr, std::forward<Args>(args)...);
+					bool added { ptr != nullptr && ptr->left == nullptr };
+					auto child { node_type::append_left(alloc, ptr, std::forward<Args>(args)...) };
+
+					if (added)
+						added_node();
+
+					return child;
 				}
 
 				//appends a right child node to the parent node pointed by ptr
 				template<class... Args>
 				node_pointer append_right(node_pointer ptr, Args&&... args)
 				{
-					return node_type::append_right(alloc, ptr, std::forward<Args>(args)...);
+					bool added { ptr != nullptr && ptr->right == nullptr };
+					auto child { node_type::append_right(alloc, ptr, std::forward<Args>(args)...) };
+
+					if (added)
+						added_node();
+
+					return child;
 				}
 
 				//gets a pointer pointing to the root node
@@ -654,7 +1178,50 @@ namespace cust					//customized / non-standard
 					return root;
 				}
 
+				const_node_pointer get_root() const noexcept
+				{
+					return root;
+				}
+
 			protected:
+				//counts a new node, the height is recomputed when it is asked for
+				void added_node() noexcept
+				{
+					++sz;
+
+					h = unknown_height;
+				}
+
+				//gets the height of the tree by a levelorder-like sweep, -1 if the tree is empty
+				difference_type count_height() const
+				{
+					std::queue<node_pointer> que    {};
+					difference_type          levels { -1 };
+
+					if (root != nullptr)
+						que.push(root);
+
+					for ( ; !que.empty(); ++levels)
+					{
+						for (auto cnt { que.size() }; cnt != 0; --cnt)
+						{
+							auto ptr { que.front() };
+
+							que.pop();
+
+							//has the left  child
+							if (ptr->left != nullptr)
+								que.push(ptr->left);
+
+							//has the right child
+							if (ptr->right != nullptr)
+								que.push(ptr->right);
+						}
+					}
+
+					return levels;
+				}
+
 				//copies the subtree rooted in the src node
 				node_pointer copy_nodes(node_pointer src)
 				{
@@ -696,85 +1263,13 @@ namespace cust					//customized / non-standard
 					return ptr;
 				}
 
-				/*
-				 *	Given the sequences of traversal results of preorder / postorder and inorder, construct the unique binary tree
-				 *
-				 *	k:
-				 *		 1, if preorder
-				 *		-1, if postorder
-				 */
-				node_pointer build_tree(const_pointer xorder, const_pointer inorder, size_type sz, int k)
-				{
-					struct info
-					{
-						node_pointer ptr;			//pointer to tree node
-						size_type    idx;			//index of tree node in inorder
-						size_type    idx_left;		//left  index range  of inorder
-						size_type    idx_right;		//right index range  of inorder
-						bool         isLC_ok;		//is left  child determined
-						bool         isRC_ok;		//is right child determined
-					};
-
-					auto get_index = [inorder, sz](const value_type& val) {
-						size_type idx { 0 };
-						
-						for ( ; idx < sz && inorder[idx] != val; ++idx);
-
-						return idx;
-					};
-
-					const size_type       start = 0 < k ? 0 : sz - 1;
-					const difference_type end   = k * (sz - start);
-
-					std::stack<info> stk {};
-					auto ptr { node_type::new_node(alloc, xorder[start]) };
-
-					stk.emplace(info { ptr, get_index(xorder[start]), 0, sz - 1, false, false });
-
-					for (difference_type i = start + k; i != end; i += k)
-					{
-						auto& top { stk.top() };
-
-						auto new_node  { node_type::new_node(alloc, xorder[i]) };
-						auto idx       { get_index(xorder[i]) };
-						auto idx_left  { top.idx_left  };
-						auto idx_right { top.idx_right };
-						auto isLC_ok   { false };
-						auto isRC_ok   { false };
-
-						if (idx < top.idx)
-						{
-							top.ptr->left = new_node;
-							top.isLC_ok   = true;
-
-							idx_right = top.idx - 1;
-						}
-						else
-						{
-							top.ptr->right = new_node;
-							top.isRC_ok    = true;
-
-							idx_left = top.idx + 1;
-						}
-
-						if (top.isLC_ok && top.isRC_ok)
-							stk.pop();
+				//the cached height is to be recomputed
+				static constexpr difference_type unknown_height { -2 };
 
-						if (idx == idx_left)
-							isLC_ok = true;
-
-						if (idx == idx_right)
-							isRC_ok = true;
-
-						if ( !(isLC_ok && isRC_ok) )
-							stk.emplace(info { new_node, idx, idx_left, idx_right, isLC_ok, isRC_ok });
-					}
-
-					return ptr;
-				}
-
-				node_pointer   root  { nullptr };		//pointer points to root node
-				allocator_type alloc {};			//allocator object
+				node_pointer                         root  { nullptr };		//pointer points to root node
+				allocator_type                       alloc {};			//allocator object
+				size_type                            sz    { 0 };			//the number of elements of the tree
+				mutable std::atomic<difference_type> h     { -1 };		//the height of the tree, unknown_height after a modification
 		};
 	}
 }
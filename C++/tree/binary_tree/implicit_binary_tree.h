@@ -0,0 +1,429 @@
+#pragma once
+
+/*
+ *	implicit binary tree, the values are embedded in one contiguous array without any pointer
+ *
+ *	a node is identified by its levelorder index i (the root is 1, the children of i are 2i and 2i + 1),
+ *	a layout maps the index of a node at depth d to its slot of the array:
+ *
+ *		bfs_layout: the slots in levelorder (heap layout), slot = i - 1
+ *		veb_layout: the slots in van Emde Boas order, a tree of height h is split into a top tree of height h / 2
+ *		            and the bottom trees below it, each of them is laid out recursively in a contiguous block,
+ *		            so a search from the root touches O(log_B n) blocks of memory for any block size B
+ *
+ *	the array has a slot for each node of the perfect tree of the same height (only up to the last node with bfs_layout),
+ *	the missing nodes of a tree which is not complete are marked absent, a complete or near-complete tree wastes little space
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <bit>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include "binary_tree.h"
+#include "vector.h"
+
+namespace cust					//customized / non-standard
+{
+	//the max number of levels of an implicit binary tree (the levelorder index of a node fits in std::size_t)
+	inline constexpr std::size_t implicit_max_levels { 63 };
+
+	//heap (BFS) layout, the slots in levelorder
+	struct bfs_layout
+	{
+		bfs_layout() noexcept = default;
+
+		explicit bfs_layout(std::size_t) noexcept
+		{
+		}
+
+		//gets the number of slots of a tree with the levels and the max levelorder index last
+		static constexpr std::size_t slots(std::size_t, std::size_t last) noexcept
+		{
+			return last;
+		}
+
+		//gets the slot of the node with index i at depth d (path: the slots of its ancestors by depth)
+		constexpr std::size_t position(std::size_t i, std::size_t, const std::size_t*) const noexcept
+		{
+			return i - 1;
+		}
+
+		constexpr std::size_t position(std::size_t i, std::size_t) const noexcept
+		{
+			return i - 1;
+		}
+	};
+
+	/*
+	 *	van Emde Boas layout
+	 *
+	 *	the depth d of the root of each bottom tree in the recursive split is unique, so the split is kept by depth:
+	 *	top_depth is the depth of the root of the top tree above it, top_size and bottom_size are the sizes of the trees,
+	 *	the slot of the node with index i at depth d is
+	 *		slot(ancestor at top_depth) + top_size + (i & top_size) * bottom_size
+	 *	(the low bits of i tell which bottom tree it is), O(1) per level when descending from the root
+	 */
+	class veb_layout
+	{
+		public:
+			veb_layout() noexcept = default;
+
+			explicit veb_layout(std::size_t levels) noexcept
+			{
+				split(0, levels);
+			}
+
+			//gets the number of slots of a tree with the levels (all nodes of the perfect tree)
+			static constexpr std::size_t slots(std::size_t levels, std::size_t) noexcept
+			{
+				return (std::size_t { 1 } << levels) - 1;
+			}
+
+			//gets the slot of the node with index i at depth d (path: the slots of its ancestors by depth)
+			std::size_t position(std::size_t i, std::size_t d, const std::size_t* path) const noexcept
+			{
+				const auto& s { splits[d] };
+
+				return d == 0 ? 0 : path[s.top_depth] + s.top_size + (i & s.top_size) * s.bottom_size;
+			}
+
+			//gets the slot of the node with index i at depth d without the path, O(log log n)
+			std::size_t position(std::size_t i, std::size_t d) const noexcept
+			{
+				const auto& s { splits[d] };
+
+				return d == 0 ? 0 : position(i >> (d - s.top_depth), s.top_depth) + s.top_size + (i & s.top_size) * s.bottom_size;
+			}
+
+		private:
+			//splits the levels [d, d + levels) into a top tree and bottom trees recursively
+			void split(std::size_t d, std::size_t levels) noexcept
+			{
+				if (levels <= 1)
+					return;
+
+				auto top    { levels / 2 };
+				auto bottom { levels - top };
+
+				splits[d + top] = split_type { d, (std::size_t { 1 } << top) - 1, (std::size_t { 1 } << bottom) - 1 };
+
+				split(d,       top);
+				split(d + top, bottom);
+			}
+
+			//the split above the root of a bottom tree at a depth
+			struct split_type
+			{
+				std::size_t top_depth;
+				std::size_t top_size;
+				std::size_t bottom_size;
+			};
+
+			split_type splits[implicit_max_levels] {};
+	};
+
+	template<class T, class Layout = bfs_layout>
+	class implicit_binary_tree
+	{
+		public:
+			using value_type      = T;
+			using size_type       = std::size_t;
+			using difference_type = std::ptrdiff_t;
+			using pointer         = value_type*;
+			using const_pointer   = const value_type*;
+			using reference       = value_type&;
+			using const_reference = const value_type&;
+			using layout_type     = Layout;
+
+			//default constructor
+			implicit_binary_tree() = default;
+
+			//converts a binary tree (anything with get_root() whose nodes have left, right and value)
+			template<class Tree, class = decltype(std::declval<const Tree&>().get_root())>
+			explicit implicit_binary_tree(const Tree& tree)
+			{
+				assign_nodes(tree.get_root());
+			}
+
+			//gets the number of elements of the tree
+			size_type size() const noexcept
+			{
+				return sz;
+			}
+
+			//checks if the tree is empty
+			bool empty() const noexcept
+			{
+				return size() == 0;
+			}
+
+			//gets the height of the tree, -1 if the tree is empty
+			difference_type height() const noexcept
+			{
+				return static_cast<difference_type>(levels) - 1;
+			}
+
+			//clears all elements of the tree
+			void clear() noexcept
+			{
+				elems.clear();
+				present.clear();
+
+				sz     = 0;
+				levels = 0;
+				last   = 0;
+			}
+
+			/*
+			 *	replaces the elements of the tree with those of the tree rooted in the root node
+			 *
+			 *	throws std::length_error if the tree has more than implicit_max_levels levels (nothing is changed then)
+			 */
+			template<class NodePtr>
+			void assign_nodes(NodePtr root)
+			{
+				std::queue<std::tuple<NodePtr, size_type, size_type>> que {};
+				size_type n { 0 }, new_levels { 0 }, new_last { 0 };
+
+				//the first pass gets the shape, the second one places the values
+				if (root != nullptr)
+					que.emplace(root, 1, 0);
+
+				for ( ; !que.empty(); que.pop())
+				{
+					auto [ptr, i, d] = que.front();
+
+					if (implicit_max_levels <= d)
+						throw std::length_error("the binary tree is too high for an implicit layout");
+
+					++n;
+
+					new_levels = std::max(new_levels, d + 1);
+					new_last   = std::max(new_last, i);
+
+					if (ptr->left != nullptr)
+						que.emplace(ptr->left,  2 * i,     d + 1);
+
+					if (ptr->right != nullptr)
+						que.emplace(ptr->right, 2 * i + 1, d + 1);
+				}
+
+				reset(n, new_levels, new_last);
+
+				if (root != nullptr)
+					que.emplace(root, 1, 0);
+
+				for ( ; !que.empty(); que.pop())
+				{
+					auto [ptr, i, d] = que.front();
+					auto slot        { layout.position(i, d) };
+
+					elems[slot]   = ptr->value;
+					present[slot] = true;
+
+					if (ptr->left != nullptr)
+						que.emplace(ptr->left,  2 * i,     d + 1);
+
+					if (ptr->right != nullptr)
+						que.emplace(ptr->right, 2 * i + 1, d + 1);
+				}
+			}
+
+			/*
+			 *	replaces the elements of the tree with the sorted range [first, last) of forward iterators
+			 *
+			 *	the shape is the complete binary tree of n nodes (levelorder indices 1 ~ n) and the values are placed in inorder,
+			 *	so the tree is a binary search tree for find()
+			 */
+			template<class ForwardIter>
+			void assign_sorted(ForwardIter first, ForwardIter last_iter)
+			{
+				auto n { static_cast<size_type>(std::distance(first, last_iter)) };
+
+				reset(n, static_cast<size_type>(std::bit_width(n)), n);
+
+				for (size_type i { 1 }; i <= n; ++i)
+					present[layout.position(i, depth(i))] = true;
+
+				depth_first(skip, [this, &first](size_type slot) { elems[slot] = *first++; }, skip);
+			}
+
+			//performs a preorder traversal
+			template<class Fn>
+			void preorder(Fn func) const
+			{
+				depth_first([this, &func](size_type slot) { func(elems[slot]); }, skip, skip);
+			}
+
+			//performs an inorder traversal
+			template<class Fn>
+			void inorder(Fn func) const
+			{
+				depth_first(skip, [this, &func](size_type slot) { func(elems[slot]); }, skip);
+			}
+
+			//performs a postorder traversal
+			template<class Fn>
+			void postorder(Fn func) const
+			{
+				depth_first(skip, skip, [this, &func](size_type slot) { func(elems[slot]); });
+			}
+
+			//performs a levelorder traversal
+			template<class Fn>
+			void levelorder(Fn func) const
+			{
+				for (size_type i { 1 }; i <= last; ++i)
+				{
+					auto slot { layout.position(i, depth(i)) };
+
+					if (present[slot])
+						func(elems[slot]);
+				}
+			}
+
+			/*
+			 *	finds the element equivalent to val by a search from the root (for a binary search tree, e.g. built by assign_sorted),
+			 *	nullptr if there is no such element
+			 */
+			template<class Ty, class Compare = std::less<>>
+			const_pointer find(const Ty& val, Compare cmp = Compare {}) const
+			{
+				size_type path[implicit_max_levels] {};
+
+				for (size_type i { 1 }, d { 0 }; d < levels && i <= last; ++d)
+				{
+					auto slot { layout.position(i, d, path) };
+
+					if ( !present[slot] )
+						break;
+
+					path[d] = slot;
+
+					if (cmp(elems[slot], val))
+						i = 2 * i + 1;
+					else if (cmp(val, elems[slot]))
+						i = 2 * i;
+					else
+						return elems.data() + slot;
+				}
+
+				return nullptr;
+			}
+
+			//checks if there is an element equivalent to val
+			template<class Ty, class Compare = std::less<>>
+			bool contains(const Ty& val, Compare cmp = Compare {}) const
+			{
+				return find(val, cmp) != nullptr;
+			}
+
+		private:
+			//does nothing with a slot in a traversal
+			static void skip(size_type) noexcept
+			{
+			}
+
+			//gets the depth of the node with levelorder index i
+			static size_type depth(size_type i) noexcept
+			{
+				return static_cast<size_type>(std::bit_width(i)) - 1;
+			}
+
+			//allocates the slots for n elements with the levels and the max levelorder index, all of them absent
+			void reset(size_type n, size_type new_levels, size_type new_last)
+			{
+				auto slots { Layout::slots(new_levels, new_last) };
+
+				vector<value_type>    new_elems   (slots);
+				vector<unsigned char> new_present (slots, 0);
+
+				elems   = std::move(new_elems);
+				present = std::move(new_present);
+				layout  = Layout(new_levels);
+
+				sz     = n;
+				levels = new_levels;
+				last   = new_last;
+			}
+
+			/*
+			 *	depth-first traversal with an explicit stack of the levelorder indices, the slot of a node is passed 3 times:
+			 *	to pre() before its left subtree, to in() between its subtrees, to post() after its right subtree
+			 *
+			 *	the slots of the nodes on the path are kept, so the slot of a child is computed in O(1)
+			 */
+			template<class Pre, class In, class Post>
+			void depth_first(Pre pre, In in, Post post) const
+			{
+				struct frame
+				{
+					size_type   i;			//levelorder index
+					size_type   slot;		//slot of the array
+					signed char state;		//0: before the left subtree, 1: before the right subtree, 2: done
+				};
+
+				frame     stk[implicit_max_levels] {};
+				size_type path[implicit_max_levels] {};
+				size_type top { 0 };
+
+				//pushes the node with index i if it exists
+				auto push = [this, &stk, &path, &top](size_type i) {
+					if (top < levels && i <= last)
+					{
+						auto slot { layout.position(i, top, path) };
+
+						if (present[slot])
+						{
+							path[top]  = slot;
+							stk[top++] = frame { i, slot, 0 };
+
+							return true;
+						}
+					}
+
+					return false;
+				};
+
+				for (push(1); 0 < top; )
+				{
+					auto& f { stk[top - 1] };
+
+					if (f.state == 0)
+					{
+						f.state = 1;
+
+						pre(f.slot);
+
+						if (push(2 * f.i))
+							continue;
+					}
+
+					if (f.state == 1)
+					{
+						f.state = 2;
+
+						in(f.slot);
+
+						if (push(2 * f.i + 1))
+							continue;
+					}
+
+					post(f.slot);
+
+					--top;
+				}
+			}
+
+			vector<value_type>    elems   {};		//the values in the slots of the layout
+			vector<unsigned char> present {};		//whether a slot holds a node
+			size_type             sz      { 0 };		//the number of elements of the tree
+			size_type             levels  { 0 };		//the number of levels (height + 1)
+			size_type             last    { 0 };		//the max levelorder index of the nodes
+			Layout                layout  {};
+	};
+}
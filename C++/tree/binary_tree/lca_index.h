@@ -0,0 +1,393 @@
+#pragma once
+
+/*
+ *	lowest common ancestor (LCA) index of a static binary tree, O(n log n) preprocessing and O(1) per query
+ *
+ *	a node is identified by its preorder index (the root is 0), for two nodes u != v with pre(u) < pre(v)
+ *		lca(u, v) = the parent with the min preorder index among the parents of the nodes in (pre(u), pre(v)]
+ *	(the parent of the first node of the range which is not in the subtree of u is the lca, any other parent is below it),
+ *	so a sparse table of the range min of the parents answers a query with two reads,
+ *	it is an Euler tour RMQ over the n - 1 tree edges instead of the 2n - 1 tour entries and no depth lookup is needed
+ *
+ *	a node pointer is mapped to its preorder index by an open addressing hash table (one cache line per lookup),
+ *	the index keeps pointers to the nodes, it must be rebuilt after the tree changes
+ *	works with any tree with get_root() whose nodes have left and right
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace cust					//customized / non-standard
+{
+	template<class Node>
+	class lca_index
+	{
+		public:
+			using size_type          = std::size_t;
+			using const_node_pointer = const Node*;
+
+			//default constructor (an empty tree)
+			lca_index() = default;
+
+			/*
+			 *	constructor with a binary tree (anything with get_root() whose nodes have left and right)
+			 *
+			 *	throws std::length_error if the tree has more than 2^32 - 1 nodes
+			 */
+			template<class Tree, class = decltype(std::declval<const Tree&>().get_root())>
+			explicit lca_index(const Tree& tree)
+			{
+				assign_nodes(tree.get_root());
+			}
+
+			//gets the number of nodes of the tree
+			size_type size() const noexcept
+			{
+				return nodes.size();
+			}
+
+			//checks if the tree is empty
+			bool empty() const noexcept
+			{
+				return size() == 0;
+			}
+
+			//replaces the index with one of the tree rooted in the root node, O(n log n)
+			void assign_nodes(const_node_pointer root)
+			{
+				std::vector<const_node_pointer> new_nodes  {};
+				std::vector<index_type>         new_depths {};
+				std::vector<index_type>         new_ends   {};
+				std::vector<index_type>         new_table  {};
+				std::vector<slot_type>          new_slots  {};
+				std::vector<std::pair<const_node_pointer, index_type>> stk {};
+
+				//preorder, the parents are the first row of the table
+				if (root != nullptr)
+					stk.emplace_back(root, 0);
+
+				while (!stk.empty())
+				{
+					auto [ptr, parent] = stk.back();
+					auto i { static_cast<index_type>(new_nodes.size()) };
+
+					stk.pop_back();
+
+					if (i == std::numeric_limits<index_type>::max())
+						throw std::length_error("the binary tree is too large for an lca index");
+
+					new_nodes.push_back(ptr);
+					new_table.push_back(parent);
+					new_depths.push_back(i == 0 ? 0 : new_depths[parent] + 1);
+
+					if (ptr->right != nullptr)
+						stk.emplace_back(ptr->right, i);
+
+					if (ptr->left != nullptr)
+						stk.emplace_back(ptr->left, i);
+				}
+
+				//the subtree of the node i is [i, i + its size) in preorder, the sizes are summed up from the last node
+				auto n { new_nodes.size() };
+
+				new_ends.assign(n, 1);
+
+				for (auto i { n }; i-- > 1; )
+					new_ends[new_table[i]] += new_ends[i];
+
+				for (size_type i { 0 }; i < n; ++i)
+					new_ends[i] += static_cast<index_type>(i);
+
+				//the row k holds the min of the parents of [i, i + 2^k)
+				auto rows { n < 2 ? 1 : static_cast<size_type>(std::bit_width(n - 1)) };
+
+				new_table.resize(rows * n);
+
+				for (size_type k { 1 }; k < rows; ++k)
+				{
+					auto prev { new_table.data() + (k - 1) * n };
+					auto curr { new_table.data() + k * n };
+					auto half { size_type { 1 } << (k - 1) };
+
+					for (size_type i { 1 }; i + 2 * half <= n; ++i)
+						curr[i] = std::min(prev[i], prev[i + half]);
+				}
+
+				//the hash table is at most 2/3 full
+				auto capacity  { std::bit_ceil(n + n / 2 + 1) };
+				auto new_shift { 64 - std::countr_zero(capacity) };
+
+				new_slots.resize(n == 0 ? 0 : capacity);
+
+				for (size_type i { 0 }; i < n; ++i)
+				{
+					auto s { slot_of(new_nodes[i], new_shift) };
+
+					while (new_slots[s].node != nullptr)
+						s = (s + 1) & (capacity - 1);
+
+					new_slots[s] = slot_type { new_nodes[i], static_cast<index_type>(i) };
+				}
+
+				nodes  = std::move(new_nodes);
+				depths = std::move(new_depths);
+				ends   = std::move(new_ends);
+				table  = std::move(new_table);
+				slots  = std::move(new_slots);
+				shift  = new_shift;
+			}
+
+			//gets the preorder index of the node, throws std::out_of_range if it is not in the tree
+			size_type index_of(const_node_pointer ptr) const
+			{
+				if (!slots.empty())
+				{
+					for (auto s { slot_of(ptr, shift) }; slots[s].node != nullptr; s = (s + 1) & (slots.size() - 1))
+					{
+						if (slots[s].node == ptr)
+							return slots[s].index;
+					}
+				}
+
+				throw std::out_of_range("the node is not in the tree");
+			}
+
+			//gets the node with the preorder index
+			const_node_pointer node(size_type i) const noexcept
+			{
+				return nodes[i];
+			}
+
+			//gets the preorder index of the parent of the node i, i itself for the root
+			size_type parent(size_type i) const noexcept
+			{
+				return table[i];
+			}
+
+			//gets the depth of the node i (the root is at depth 0)
+			size_type depth(size_type i) const noexcept
+			{
+				return depths[i];
+			}
+
+			//checks if the node a is an ancestor of the node b (a node is an ancestor of itself)
+			bool is_ancestor(size_type a, size_type b) const noexcept
+			{
+				return a <= b && b < ends[a];
+			}
+
+			bool is_ancestor(const_node_pointer a, const_node_pointer b) const
+			{
+				return is_ancestor(index_of(a), index_of(b));
+			}
+
+			//gets the preorder index of the lowest common ancestor of the nodes a and b, O(1)
+			size_type lca(size_type a, size_type b) const noexcept
+			{
+				if (a == b)
+					return a;
+
+				auto [row, l, r] = locate(a, b);
+
+				return std::min(row[l], row[r]);
+			}
+
+			//gets the lowest common ancestor of the nodes a and b, throws std::out_of_range if one is not in the tree
+			const_node_pointer lca(const_node_pointer a, const_node_pointer b) const
+			{
+				return nodes[lca(index_of(a), index_of(b))];
+			}
+
+			//gets the number of edges on the path between the nodes a and b
+			size_type distance(size_type a, size_type b) const noexcept
+			{
+				return depths[a] + depths[b] - 2 * depths[lca(a, b)];
+			}
+
+			size_type distance(const_node_pointer a, const_node_pointer b) const
+			{
+				return distance(index_of(a), index_of(b));
+			}
+
+			//writes the preorder indices of the nodes on the path from the node a to the node b (both included)
+			template<class OutputIt>
+			OutputIt path(size_type a, size_type b, OutputIt d_first) const
+			{
+				auto top { lca(a, b) };
+
+				for ( ; a != top; a = table[a])
+					*d_first++ = a;
+
+				*d_first++ = top;
+
+				//the part below the lca on the side of b is written from its lowest node upward
+				std::vector<size_type> down(depths[b] - depths[top]);
+
+				for (auto it { down.rbegin() }; b != top; b = table[b])
+					*it++ = b;
+
+				return std::copy(down.begin(), down.end(), d_first);
+			}
+
+			/*
+			 *	answers a batch of queries, the range [first, last) of pairs of nodes (preorder indices or node pointers),
+			 *	and writes the lowest common ancestors in the order of the queries (of the same type as the pairs)
+			 *
+			 *	the queries are processed in a pipeline over a window of the range (it is read three times):
+			 *	the hash table slots of the nodes are prefetched 2 * batch_distance queries ahead,
+			 *	the preorder indices are looked up and the two table entries prefetched batch_distance queries ahead,
+			 *	so the cache misses of many queries overlap instead of stalling each query in turn
+			 */
+			template<class ForwardIt, class OutputIt>
+			OutputIt lca(ForwardIt first, ForwardIt last, OutputIt d_first) const
+			{
+				using result_type = std::remove_cvref_t<decltype(std::get<0>(*first))>;
+
+				std::array<std::pair<size_type, size_type>, batch_distance> window {};
+				size_type done { 0 }, resolved { 0 };
+				auto lookup { first };
+
+				auto look_ahead = [&]()
+				{
+					if constexpr (!std::is_convertible_v<result_type, const_node_pointer>)
+						return;
+					else if (lookup != last)
+					{
+						prefetch_slot(std::get<0>(*lookup));
+						prefetch_slot(std::get<1>(*lookup));
+						++lookup;
+					}
+				};
+
+				auto resolve = [&]()
+				{
+					if (first == last)
+						return;
+
+					auto a { to_index(std::get<0>(*first)) };
+					auto b { to_index(std::get<1>(*first)) };
+
+					if (a != b)
+					{
+						auto [row, l, r] = locate(a, b);
+
+						prefetch(row + l);
+						prefetch(row + r);
+					}
+
+					window[resolved++ % batch_distance] = { a, b };
+					++first;
+				};
+
+				for (size_type i { 0 }; i < batch_distance; ++i)
+					look_ahead();
+
+				for (size_type i { 0 }; i < batch_distance; ++i)
+				{
+					look_ahead();
+					resolve();
+				}
+
+				while (done < resolved)
+				{
+					auto [a, b] = window[done++ % batch_distance];
+					auto i      { lca(a, b) };
+
+					if constexpr (std::is_convertible_v<result_type, const_node_pointer>)
+						*d_first++ = nodes[i];
+					else
+						*d_first++ = static_cast<result_type>(i);
+
+					look_ahead();
+					resolve();
+				}
+
+				return d_first;
+			}
+
+		private:
+			using index_type = std::uint32_t;
+
+			//an entry of the hash table of the nodes, empty if node is nullptr
+			struct slot_type
+			{
+				const_node_pointer node  { nullptr };
+				index_type         index { 0 };
+			};
+
+			//the number of queries of a batch in flight in each stage of the pipeline
+			static constexpr size_type batch_distance { 16 };
+
+			//gets the home slot of the node by Fibonacci hashing (the high bits of the product are the best mixed)
+			static size_type slot_of(const_node_pointer ptr, int bits) noexcept
+			{
+				return static_cast<size_type>((static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr)) * 0x9e3779b97f4a7c15) >> bits);
+			}
+
+			//gets the row of the table and the two positions read by the query of the nodes a != b
+			std::tuple<const index_type*, size_type, size_type> locate(size_type a, size_type b) const noexcept
+			{
+				auto l { std::min(a, b) + 1 };
+				auto r { std::max(a, b) + 1 };
+				auto k { static_cast<size_type>(std::bit_width(r - l)) - 1 };
+
+				return { table.data() + k * nodes.size(), l, r - (size_type { 1 } << k) };
+			}
+
+			//hints the CPU to load the cache line of the address
+			static void prefetch(const void* ptr) noexcept
+			{
+#if defined(__GNUC__) || defined(__clang__)
+				__builtin_prefetch(ptr);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+				_mm_prefetch(static_cast<const char*>(ptr), _MM_HINT_T0);
+#else
+				static_cast<void>(ptr);
+#endif
+			}
+
+			void prefetch_slot(size_type) const noexcept
+			{
+			}
+
+			void prefetch_slot(const_node_pointer ptr) const noexcept
+			{
+				if (!slots.empty())
+					prefetch(slots.data() + slot_of(ptr, shift));
+			}
+
+			size_type to_index(size_type i) const noexcept
+			{
+				return i;
+			}
+
+			size_type to_index(const_node_pointer ptr) const
+			{
+				return index_of(ptr);
+			}
+
+			std::vector<const_node_pointer> nodes  {};		//the nodes in preorder
+			std::vector<index_type>         depths {};		//the depths of the nodes
+			std::vector<index_type>         ends   {};		//one past the last preorder index of the subtrees
+			std::vector<index_type>         table  {};		//the sparse table, the row 0 is the parents
+			std::vector<slot_type>          slots  {};		//the hash table of the preorder indices of the nodes
+			int                             shift  { 64 };		//64 - log2 of the number of slots
+	};
+
+	//deduces the node type of a tree
+	template<class Tree>
+	lca_index(const Tree&) -> lca_index<std::remove_cvref_t<decltype(*std::declval<const Tree&>().get_root())>>;
+}
@@ -0,0 +1,619 @@
+#pragma once
+
+/*
+ *	succinct binary tree, the shape is encoded in a balanced parentheses (BP) bit vector of 2n bits
+ *	and the values are stored in one contiguous array in preorder
+ *
+ *	a node is encoded as ( left ) right, a '(' is the bit 1 and a ')' is the bit 0 (any balanced sequence is a binary tree),
+ *	a node is identified by the position p of its '(' (the root is 0), then
+ *		left(p)         = p + 1 if it is a '('
+ *		right(p)        = close(p) + 1 if it is a '('
+ *		parent(p)       = p - 1 if it is a '(' (p is a left child), otherwise open(p - 1) (p is a right child)
+ *		subtree_size(p) = (close(enclose(p)) - p) / 2 (the right subtree ends before the ')' of the node enclosing p)
+ *		value(p)        = values[rank1(p)]
+ *
+ *	rank1 is O(1) by a count of the ones before each block of 512 bits,
+ *	close, open and enclose search for a position of an excess (the number of '(' minus the number of ')' up to it)
+ *	by a table of 256 bytes within the block and a range min-max tree of the min excess of the blocks above it,
+ *	O(1) within a block (a subtree of up to about 256 nodes) and O(log(n / 512)) in general,
+ *	the indexes take 3 / 16 bits per bit, about 2.4 bits per node with the shape
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cust					//customized / non-standard
+{
+	template<class T>
+	class succinct_binary_tree
+	{
+		public:
+			using value_type      = T;
+			using size_type       = std::size_t;
+			using difference_type = std::ptrdiff_t;
+			using reference       = value_type&;
+			using const_reference = const value_type&;
+
+			//the position of a node which does not exist
+			static constexpr size_type npos { static_cast<size_type>(-1) };
+
+			//default constructor
+			succinct_binary_tree() = default;
+
+			//encodes a binary tree (anything with get_root() whose nodes have left, right and value)
+			template<class Tree, class = decltype(std::declval<const Tree&>().get_root())>
+			explicit succinct_binary_tree(const Tree& tree)
+			{
+				assign_nodes(tree.get_root());
+			}
+
+			//gets the number of elements of the tree
+			size_type size() const noexcept
+			{
+				return values.size();
+			}
+
+			//checks if the tree is empty
+			bool empty() const noexcept
+			{
+				return size() == 0;
+			}
+
+			//clears all elements of the tree
+			void clear() noexcept
+			{
+				words.clear();
+				ranks.clear();
+				mins.clear();
+				values.clear();
+
+				leaves = 0;
+			}
+
+			/*
+			 *	replaces the elements of the tree with those of the tree rooted in the root node, O(n)
+			 *
+			 *	throws std::length_error if the tree has 2^30 nodes or more (nothing is changed then)
+			 */
+			template<class NodePtr>
+			void assign_nodes(NodePtr root)
+			{
+				std::vector<std::uint64_t> new_words  {};
+				std::vector<value_type>    new_values {};
+				std::vector<NodePtr>       stk        {};
+				size_type                  len        { 0 };
+
+				//a nullptr on the stack is the ')' after a left subtree
+				if (root != nullptr)
+					stk.push_back(root);
+
+				while (!stk.empty())
+				{
+					auto ptr { stk.back() };
+
+					stk.pop_back();
+
+					if (len % 64 == 0)
+						new_words.push_back(0);
+
+					if (ptr != nullptr)
+					{
+						if (max_size() <= new_values.size())
+							throw std::length_error("the binary tree is too large for a succinct encoding");
+
+						new_words.back() |= std::uint64_t { 1 } << (len % 64);
+						new_values.push_back(ptr->value);
+
+						if (ptr->right != nullptr)
+							stk.push_back(ptr->right);
+
+						stk.push_back(nullptr);
+
+						if (ptr->left != nullptr)
+							stk.push_back(ptr->left);
+					}
+
+					++len;
+				}
+
+				words  = std::move(new_words);
+				values = std::move(new_values);
+
+				build_indexes();
+			}
+
+			//decodes the tree into a binary tree (with add_root, append_left and append_right), O(n)
+			template<class Tree>
+			void decode(Tree& tree) const
+			{
+				tree.clear();
+
+				if (empty())
+					return;
+
+				std::vector<decltype(tree.get_root())> stk { tree.add_root(values[0]) };
+				decltype(tree.get_root())              closed { nullptr };		//the node of the last ')'
+				size_type                              k { 1 };
+
+				//a '(' after a '(' is a left child, after a ')' it is a right child of the node closed by it
+				for (size_type i { 1 }; i < 2 * size(); ++i)
+				{
+					if (bit(i))
+					{
+						stk.push_back(closed == nullptr ? tree.append_left(stk.back(), values[k]) : tree.append_right(closed, values[k]));
+
+						closed = nullptr;
+						++k;
+					}
+					else
+					{
+						closed = stk.back();
+						stk.pop_back();
+					}
+				}
+			}
+
+			/*
+			 *	writes the tree to the stream: the number of elements, the bit vector and the values in the native byte order,
+			 *	2n bits + n values, the indexes are rebuilt by read()
+			 */
+			void write(std::ostream& os) const requires std::is_trivially_copyable_v<T>
+			{
+				std::uint64_t n { size() };
+
+				os.write(reinterpret_cast<const char*>(&n), sizeof(n));
+				os.write(reinterpret_cast<const char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(std::uint64_t)));
+				os.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(value_type)));
+			}
+
+			/*
+			 *	replaces the elements of the tree with those read from the stream written by write(), O(n)
+			 *
+			 *	throws std::invalid_argument if the stream is truncated or its bits are not balanced (nothing is changed then)
+			 */
+			void read(std::istream& is) requires std::is_trivially_copyable_v<T>
+			{
+				std::uint64_t n { 0 };
+
+				if ( !is.read(reinterpret_cast<char*>(&n), sizeof(n)) || max_size() <= n )
+					throw std::invalid_argument("the stream is not a succinct binary tree");
+
+				//the count is not trusted for an allocation before the bits and the values are actually read
+				std::vector<std::uint64_t> new_words  {};
+				std::vector<value_type>    new_values {};
+
+				if ( !read_chunks(is, new_words, (2 * n + 63) / 64) || !read_chunks(is, new_values, n) )
+					throw std::invalid_argument("the stream is not a succinct binary tree");
+
+				//the excess must never be negative and end at 0, and the unused bits must be 0
+				std::int64_t excess { 0 };
+
+				for (size_type i { 0 }; 0 <= excess && i < 2 * n; ++i)
+					excess += (new_words[i / 64] >> (i % 64)) & 1 ? 1 : -1;
+
+				if ( excess != 0 || (2 * n % 64 != 0 && new_words.back() >> (2 * n % 64) != 0) )
+					throw std::invalid_argument("the stream is not a succinct binary tree");
+
+				words  = std::move(new_words);
+				values = std::move(new_values);
+
+				build_indexes();
+			}
+
+			//gets the root node, npos if the tree is empty
+			size_type root() const noexcept
+			{
+				return empty() ? npos : 0;
+			}
+
+			//gets the left child of the node p, npos if there is none
+			size_type left(size_type p) const noexcept
+			{
+				return bit(p + 1) ? p + 1 : npos;
+			}
+
+			//gets the right child of the node p, npos if there is none
+			size_type right(size_type p) const noexcept
+			{
+				auto q { close(p) + 1 };
+
+				return q < 2 * size() && bit(q) ? q : npos;
+			}
+
+			//gets the parent of the node p, npos for the root
+			size_type parent(size_type p) const noexcept
+			{
+				if (p == 0)
+					return npos;
+
+				return bit(p - 1) ? p - 1 : open(p - 1);
+			}
+
+			//gets the number of elements of the subtree rooted in the node p
+			size_type subtree_size(size_type p) const noexcept
+			{
+				auto e { enclose(p) };
+
+				return ((e == npos ? 2 * size() : close(e)) - p) / 2;
+			}
+
+			//gets the preorder index of the node p
+			size_type preorder_index(size_type p) const noexcept
+			{
+				return rank1(p);
+			}
+
+			//gets the value of the node p
+			reference value(size_type p) noexcept
+			{
+				return values[rank1(p)];
+			}
+
+			const_reference value(size_type p) const noexcept
+			{
+				return values[rank1(p)];
+			}
+
+			//performs a preorder traversal
+			template<class Fn>
+			void preorder(Fn func) const
+			{
+				for (const auto& val : values)
+					func(val);
+			}
+
+			//performs an inorder traversal
+			template<class Fn>
+			void inorder(Fn func) const
+			{
+				depth_first(skip, [this, &func](size_type k) { func(values[k]); }, skip);
+			}
+
+			//performs a postorder traversal
+			template<class Fn>
+			void postorder(Fn func) const
+			{
+				depth_first(skip, skip, [this, &func](size_type k) { func(values[k]); });
+			}
+
+		private:
+			//appends count elements read from the stream to vec in chunks of 64 KiB, so a truncated stream allocates no more than it holds
+			template<class U>
+			static bool read_chunks(std::istream& is, std::vector<U>& vec, std::uint64_t count)
+			{
+				constexpr std::uint64_t chunk { std::max<std::uint64_t>(1, (1 << 16) / sizeof(U)) };
+
+				for (std::uint64_t done { 0 }; done < count && is; )
+				{
+					auto len { std::min(chunk, count - done) };
+
+					vec.resize(static_cast<std::size_t>(done + len));
+					is.read(reinterpret_cast<char*>(vec.data() + done), static_cast<std::streamsize>(len * sizeof(U)));
+
+					done += len;
+				}
+
+				return static_cast<bool>(is);
+			}
+
+			//the number of bits of a block of the rank counts and the range min-max tree
+			static constexpr size_type block_bits { 512 };
+
+			//the excess of each byte and the min excess after each bit of it (the first bit is the least significant one)
+			struct byte_table_type
+			{
+				std::array<std::int8_t, 256> excess {};
+				std::array<std::int8_t, 256> min    {};
+			};
+
+			static constexpr byte_table_type byte_table { []()
+			{
+				byte_table_type table {};
+
+				for (int b { 0 }; b < 256; ++b)
+				{
+					int excess { 0 }, min { 8 };
+
+					for (int i { 0 }; i < 8; ++i)
+					{
+						excess += (b >> i) & 1 ? 1 : -1;
+						min     = std::min(min, excess);
+					}
+
+					table.excess[b] = static_cast<std::int8_t>(excess);
+					table.min[b]    = static_cast<std::int8_t>(min);
+				}
+
+				return table;
+			}() };
+
+			//gets the max number of elements (the excess and the ranks fit in 32 bits)
+			static constexpr size_type max_size() noexcept
+			{
+				return size_type { 1 } << 30;
+			}
+
+			//does nothing with an element in a traversal
+			static void skip(size_type) noexcept
+			{
+			}
+
+			/*
+			 *	scans the bits once with a stack of the preorder indices of the nodes whose right subtree is not finished,
+			 *	a ')' finishes the nodes closed above the node it closes (their right subtrees end with its left subtree)
+			 */
+			template<class Pre, class In, class Post>
+			void depth_first(Pre pre, In in, Post post) const
+			{
+				std::vector<std::pair<size_type, bool>> stk {};		//the preorder index and if its ')' is passed
+				size_type k { 0 };
+
+				for (size_type i { 0 }; i < 2 * size(); ++i)
+				{
+					if (bit(i))
+					{
+						pre(k);
+						stk.emplace_back(k++, false);
+
+						continue;
+					}
+
+					for ( ; stk.back().second; stk.pop_back())
+						post(stk.back().first);
+
+					stk.back().second = true;
+					in(stk.back().first);
+				}
+
+				for ( ; !stk.empty(); stk.pop_back())
+					post(stk.back().first);
+			}
+
+			//gets the bit at the position i
+			bool bit(size_type i) const noexcept
+			{
+				return (words[i / 64] >> (i % 64)) & 1;
+			}
+
+			//gets the byte of the bits [i, i + 8), i is a multiple of 8
+			std::uint8_t byte(size_type i) const noexcept
+			{
+				return static_cast<std::uint8_t>(words[i / 64] >> (i % 64));
+			}
+
+			//gets the number of ones in [0, i)
+			size_type rank1(size_type i) const noexcept
+			{
+				auto count { static_cast<size_type>(ranks[i / block_bits]) };
+
+				for (auto w { i / block_bits * (block_bits / 64) }; w < i / 64; ++w)
+					count += static_cast<size_type>(std::popcount(words[w]));
+
+				if (i % 64 != 0)
+					count += static_cast<size_type>(std::popcount(words[i / 64] << (64 - i % 64)));
+
+				return count;
+			}
+
+			//gets the excess at the position i (after its bit), excess(-1) is 0
+			std::int64_t excess(size_type i) const noexcept
+			{
+				return 2 * static_cast<std::int64_t>(rank1(i + 1)) - static_cast<std::int64_t>(i + 1);
+			}
+
+			//gets the matching ')' of the '(' at the position p
+			size_type close(size_type p) const noexcept
+			{
+				return forward_search(p, excess(p) - 1);
+			}
+
+			//gets the matching '(' of the ')' at the position q
+			size_type open(size_type q) const noexcept
+			{
+				return static_cast<size_type>(backward_search(q, excess(q)) + 1);
+			}
+
+			//gets the '(' of the innermost pair enclosing the '(' at the position p, npos if there is none
+			size_type enclose(size_type p) const noexcept
+			{
+				auto j { backward_search(p, excess(p) - 2) };
+
+				return j == not_found ? npos : static_cast<size_type>(j + 1);
+			}
+
+			static constexpr difference_type not_found { -2 };
+
+			/*
+			 *	gets the first position j in [from, to) whose excess is at most target (excess is the excess at from - 1),
+			 *	the next 8 bits are skipped at once if their min excess is above the target, npos if there is none
+			 */
+			size_type scan_forward(size_type from, size_type to, std::int64_t excess, std::int64_t target) const noexcept
+			{
+				for (auto i { from }; i < to; )
+				{
+					auto w    { words[i / 64] >> (i % 64) };
+					auto last { std::min(to, (i / 64 + 1) * 64) };
+
+					while (i < last)
+					{
+						if (i + 8 <= last && target < excess + byte_table.min[w & 0xff])
+						{
+							excess += byte_table.excess[w & 0xff];
+							w     >>= 8;
+							i      += 8;
+
+							continue;
+						}
+
+						excess += w & 1 ? 1 : -1;
+
+						if (excess <= target)
+							return i;
+
+						w >>= 1;
+						++i;
+					}
+				}
+
+				return npos;
+			}
+
+			//gets the last position j in [from, to) whose excess is at most target (excess is the excess at to - 1), npos if there is none
+			size_type scan_backward(size_type from, size_type to, std::int64_t excess, std::int64_t target) const noexcept
+			{
+				for (auto i { to }; from < i; )
+				{
+					//the bit of the position i - 1 is the most significant one
+					auto w     { words[(i - 1) / 64] << (63 - (i - 1) % 64) };
+					auto first { std::max(from, (i - 1) / 64 * 64) };
+
+					while (first < i)
+					{
+						if (first + 8 <= i)
+						{
+							auto b      { static_cast<std::uint8_t>(w >> 56) };
+							auto before { excess - byte_table.excess[b] };
+
+							if (target < before + byte_table.min[b])
+							{
+								excess  = before;
+								w     <<= 8;
+								i      -= 8;
+
+								continue;
+							}
+						}
+
+						if (excess <= target)
+							return i - 1;
+
+						excess -= w >> 63 ? 1 : -1;
+						w     <<= 1;
+						--i;
+					}
+				}
+
+				return npos;
+			}
+
+			//gets the first position after i whose excess is at most target (< excess(i)), npos if there is none
+			size_type forward_search(size_type i, std::int64_t target) const noexcept
+			{
+				auto len { 2 * size() };
+				auto b   { i / block_bits };
+				auto j   { scan_forward(i + 1, std::min((b + 1) * block_bits, len), excess(i), target) };
+
+				if (j != npos)
+					return j;
+
+				//up to the first right sibling with the min excess at most the target, then down to its leftmost such block
+				for (auto v { leaves + b }; 1 < v; v /= 2)
+				{
+					if (v % 2 == 0 && mins[v + 1] <= target)
+					{
+						for (++v; v < leaves; )
+							v = mins[2 * v] <= target ? 2 * v : 2 * v + 1;
+
+						auto first { (v - leaves) * block_bits };
+
+						return scan_forward(first, std::min(first + block_bits, len), 2 * std::int64_t { ranks[v - leaves] } - static_cast<std::int64_t>(first), target);
+					}
+				}
+
+				return npos;
+			}
+
+			/*
+			 *	gets the last position before i whose excess is at most target (< excess(i - 1)),
+			 *	-1 if there is none but excess(-1) = 0 is at most target, otherwise not_found
+			 */
+			difference_type backward_search(size_type i, std::int64_t target) const noexcept
+			{
+				auto none { target < 0 ? not_found : -1 };
+
+				if (i == 0)
+					return none;
+
+				auto b { (i - 1) / block_bits };
+				auto j { scan_backward(b * block_bits, i, excess(i - 1), target) };
+
+				if (j != npos)
+					return static_cast<difference_type>(j);
+
+				//up to the first left sibling with the min excess at most the target, then down to its rightmost such block
+				for (auto v { leaves + b }; 1 < v; v /= 2)
+				{
+					if (v % 2 == 1 && mins[v - 1] <= target)
+					{
+						for (--v; v < leaves; )
+							v = mins[2 * v + 1] <= target ? 2 * v + 1 : 2 * v;
+
+						auto first { (v - leaves) * block_bits };
+						auto last  { std::min(first + block_bits, 2 * size()) };
+
+						return static_cast<difference_type>(scan_backward(first, last, excess(last - 1), target));
+					}
+				}
+
+				return none;
+			}
+
+			//builds the rank counts and the range min-max tree of the bits, O(n)
+			void build_indexes()
+			{
+				auto len    { 2 * size() };
+				auto blocks { (len + block_bits - 1) / block_bits };
+
+				leaves = std::bit_ceil(std::max(blocks, size_type { 1 }));
+
+				ranks.assign(blocks + 1, 0);
+				mins.assign(2 * leaves, std::numeric_limits<std::int32_t>::max());
+
+				std::int32_t excess { 0 };
+
+				for (size_type b { 0 }; b < blocks; ++b)
+				{
+					auto& min { mins[leaves + b] };
+
+					//the last byte may be partial (a length of 2n bits is not a multiple of 8)
+					for (auto i { b * block_bits }, last { std::min((b + 1) * block_bits, len) }; i < last; )
+					{
+						if (i + 8 <= last)
+						{
+							auto u { byte(i) };
+
+							min     = std::min(min, excess + byte_table.min[u]);
+							excess += byte_table.excess[u];
+							i      += 8;
+						}
+						else
+						{
+							excess += bit(i++) ? 1 : -1;
+							min     = std::min(min, excess);
+						}
+					}
+
+					ranks[b + 1] = static_cast<std::uint32_t>((excess + static_cast<std::int32_t>(std::min((b + 1) * block_bits, len))) / 2);
+				}
+
+				for (auto v { leaves }; v-- > 1; )
+					mins[v] = std::min(mins[2 * v], mins[2 * v + 1]);
+			}
+
+			std::vector<std::uint64_t> words  {};		//the bits of the shape, 2n bits
+			std::vector<std::uint32_t> ranks  {};		//the number of ones before each block
+			std::vector<std::int32_t>  mins   {};		//the range min-max tree, the min excess of the blocks (1-based heap)
+			std::vector<value_type>    values {};		//the values in preorder
+			size_type                  leaves { 0 };		//the number of leaves of the range min-max tree
+	};
+}